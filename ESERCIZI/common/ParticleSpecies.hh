@@ -0,0 +1,126 @@
+/**
+ * @file   ParticleSpecies.hh
+ *
+ * @brief  PDG encoding to species and short name
+ */
+
+#ifndef PARTICLESPECIES_HH_
+#define PARTICLESPECIES_HH_
+
+#include <algorithm>
+
+/*!
+ * \brief Table of the particles and ions met in the detectors.
+ *
+ * Maps the PDG encoding (ions: 100ZZZAAAI) to a species and a short name,
+ * used to classify tracks without comparing particle names. The table
+ * is a constant array sorted by encoding: it is built by the compiler,
+ * the look-up is a binary search and nothing is allocated.
+ * The names are those of the npConv analysis (alpha is He4).
+ * Excited ions (I>0) are not in the table and give kUnknown.
+ * Used by NeutronGEM and by the npConv analysis (gasAnalysis, OldProcCla).
+ */
+class ParticleSpecies
+{
+public:
+	enum Species {
+		kUnknown=0,
+		kPositron,
+		kElectron,
+		kGamma,
+		kNeutron,
+		kProton,
+		kDeuteron,
+		kTriton,
+		kHe3,
+		kAlpha,
+		kLi6,
+		kLi7,
+		kB10,
+		kB11,
+		kC12,
+		kC13,
+		kO16,
+		kO17,
+		kO18,
+		kS33,
+		kS37,
+		kCl36,
+		kAr36,
+		kAr37,
+		kAr38,
+		kAr40,
+		kAr41,
+		kNi63,
+		kCu63,
+		kCu65,
+		kGe70,
+		kGe72,
+		kGe74,
+		kGe76,
+		kNumberOfSpecies
+	};
+
+	//! Species of this PDG encoding, kUnknown if not in the table
+	static Species GetSpecies( int pdg ) {
+		const Entry* entry = Find(pdg);
+		return entry ? entry->species : kUnknown;
+	}
+	//! Short name (g, p, Ar40, ...), 0 if not in the table
+	static const char* GetName( int pdg ) {
+		const Entry* entry = Find(pdg);
+		return entry ? entry->name : 0;
+	}
+
+private:
+	struct Entry {
+		int pdg;
+		Species species;
+		const char* name;
+		bool operator<( int code ) const { return pdg < code; }
+	};
+
+	static const Entry* Find( int pdg ) {
+		//Constant initialisation: no run-time construction. Keep sorted by pdg
+		static const Entry table[] = {
+			{ -11 , kPositron , "e+" },
+			{ 11 , kElectron , "e-" },
+			{ 22 , kGamma , "g" },
+			{ 2112 , kNeutron , "n" },
+			{ 2212 , kProton , "p" },
+			{ 1000010020 , kDeuteron , "H2" },
+			{ 1000010030 , kTriton , "H3" },
+			{ 1000020030 , kHe3 , "He3" },
+			{ 1000020040 , kAlpha , "He4" },
+			{ 1000030060 , kLi6 , "Li6" },
+			{ 1000030070 , kLi7 , "Li7" },
+			{ 1000050100 , kB10 , "B10" },
+			{ 1000050110 , kB11 , "B11" },
+			{ 1000060120 , kC12 , "C12" },
+			{ 1000060130 , kC13 , "C13" },
+			{ 1000080160 , kO16 , "O16" },
+			{ 1000080170 , kO17 , "O17" },
+			{ 1000080180 , kO18 , "O18" },
+			{ 1000160330 , kS33 , "S33" },
+			{ 1000160370 , kS37 , "S37" },
+			{ 1000170360 , kCl36 , "Cl36" },
+			{ 1000180360 , kAr36 , "Ar36" },
+			{ 1000180370 , kAr37 , "Ar37" },
+			{ 1000180380 , kAr38 , "Ar38" },
+			{ 1000180400 , kAr40 , "Ar40" },
+			{ 1000180410 , kAr41 , "Ar41" },
+			{ 1000280630 , kNi63 , "Ni63" },
+			{ 1000290630 , kCu63 , "Cu63" },
+			{ 1000290650 , kCu65 , "Cu65" },
+			{ 1000320700 , kGe70 , "Ge70" },
+			{ 1000320720 , kGe72 , "Ge72" },
+			{ 1000320740 , kGe74 , "Ge74" },
+			{ 1000320760 , kGe76 , "Ge76" },
+		};
+		static const Entry* end = table + sizeof(table)/sizeof(table[0]);
+		const Entry* entry = std::lower_bound( table , end , pdg );
+		return ( entry != end && entry->pdg == pdg ) ? entry : 0;
+	}
+};
+
+#endif /* PARTICLESPECIES_HH_ */
@@ -0,0 +1,302 @@
+/*
+ * @file ProgressReporter.hh
+ *
+ * \brief ProgressReporter and ProgressReporterMessenger classes
+ *
+ * Shared by all the applications of the exercises: the header contains
+ * the whole implementation, add the directory ESERCIZI/common to the
+ * include path of the application.
+ */
+
+#ifndef PROGRESSREPORTER_HH_
+#define PROGRESSREPORTER_HH_
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+
+#ifdef G4MULTITHREADED
+#include "G4RunManager.hh"
+#include "G4Run.hh"
+#endif
+
+#include <sys/time.h>
+#include <unistd.h>
+#include <fstream>
+
+//Geant4 versions before 10.0 have no thread local storage
+#ifndef G4ThreadLocal
+#define G4ThreadLocal
+#endif
+
+class ProgressReporterMessenger;
+
+/*!
+ * \brief Prints the progress of the current run at fixed wall-clock intervals.
+ *
+ * Every few seconds of wall time (/progress/interval) a line reports the number
+ * of events done, the average and instantaneous event rate and the
+ * estimated time to the end of the /run/beamOn. With /progress/verbose 2
+ * the step rate and the resident memory of the process are added.
+ * With /progress/verbose 0 nothing is printed and the wall clock is
+ * never read: only a counter is incremented at each step and event.
+ *
+ * Create the instance in the constructor of the RunAction, so that the
+ * /progress/ commands exist before the first run. Call BeginOfRun() and
+ * EndOfRun() from the RunAction, EndOfEvent() from the EventAction and
+ * AddStep() from the SteppingAction (if any, otherwise the step rate is
+ * not printed).
+ * The class is designed as a singleton, with one instance per thread:
+ * in a multithreaded run each worker reports on its own events, without
+ * total and ETA (its share of the run is not known in advance), and the
+ * master, which processes no event, only prints the summary of the whole
+ * run at the end.
+ */
+class ProgressReporter {
+public:
+	//! Singleton pattern
+	static ProgressReporter* GetInstance() {
+		static G4ThreadLocal ProgressReporter* singleton = 0;
+		if ( singleton == 0 ) singleton = new ProgressReporter();
+		return singleton;
+	}
+	//! destructor
+	virtual ~ProgressReporter();
+	//! Reset counters and clock, numEvents is the number of events requested
+	void BeginOfRun( G4int numEvents );
+	//! Count an event and print a report if the interval has elapsed
+	void EndOfEvent() {
+		++eventsDone;
+		if ( verbose > 0 && --eventsToCheck <= 0 ) CheckTime();
+	}
+	//! Count a step
+	void AddStep() { ++stepsDone; }
+	//! Print the summary of the run
+	void EndOfRun();
+
+	//! \name set functions used by the messenger
+	//@{
+	void SetVerbose( G4int val ) { verbose = val; }
+	void SetInterval( G4double seconds ) { interval = seconds; }
+	//@}
+private:
+	//! Private construtor: part of singleton pattern
+	ProgressReporter();
+	ProgressReporterMessenger* messenger;
+
+	//! Read the clock and print if needed
+	void CheckTime();
+	//! Print one report line
+	void Report( G4double now );
+	//! Wall clock in seconds
+	static G4double WallTime();
+	//! Resident memory of the process in MB, 0 if not available
+	static G4double ResidentMemory();
+
+	G4int verbose;
+	//! \name role of the thread in a multithreaded run
+	//@{
+	G4bool master;
+	G4bool worker;
+	//@}
+	//! Seconds between two reports
+	G4double interval;
+
+	G4int eventsRequested;
+	G4int eventsDone;
+	G4double stepsDone;
+	G4double startTime;
+	//! \name values at the previous report, for the instantaneous rates
+	//@{
+	G4double lastTime;
+	G4int lastEvents;
+	G4double lastSteps;
+	//@}
+	//! Time of the previous clock read
+	G4double lastCheck;
+	//! Events before the clock is read again: slow events are checked each
+	//! time, fast events only a few times per interval
+	G4int eventsToCheck;
+	G4int checkEvery;
+};
+
+/*!
+ * \brief This class provides the user interface to ProgressReporter
+ *
+ * \sa SetNewValue()
+ */
+class ProgressReporterMessenger : public G4UImessenger
+{
+public:
+	//! Constructor
+	ProgressReporterMessenger(ProgressReporter*);
+	//! Destructor
+	virtual ~ProgressReporterMessenger();
+	//! handle user commands
+	void SetNewValue(G4UIcommand*,G4String);
+private:
+	ProgressReporter*		reporter;
+
+	G4UIdirectory*			progressDir;
+	G4UIcmdWithAnInteger*	verboseCmd;
+	G4UIcmdWithADouble*		intervalCmd;
+};
+
+inline ProgressReporter::ProgressReporter() :
+	verbose(1),
+	master(false),
+	worker(false),
+	interval(10.),
+	eventsRequested(0),
+	eventsDone(0),
+	stepsDone(0),
+	startTime(0),
+	lastTime(0),
+	lastEvents(0),
+	lastSteps(0),
+	lastCheck(0),
+	eventsToCheck(1),
+	checkEvery(1)
+{
+	messenger = new ProgressReporterMessenger(this);
+}
+
+inline ProgressReporter::~ProgressReporter()
+{
+	delete messenger;
+}
+
+inline G4double ProgressReporter::WallTime()
+{
+	struct timeval tv;
+	gettimeofday(&tv,0);
+	return tv.tv_sec + 1e-6*tv.tv_usec;
+}
+
+inline G4double ProgressReporter::ResidentMemory()
+{
+	//Second field of statm is the number of resident pages (Linux only)
+	std::ifstream statm("/proc/self/statm");
+	long pages = 0, resident = 0;
+	if ( !(statm>>pages>>resident) ) return 0;
+	return resident*static_cast<G4double>(sysconf(_SC_PAGESIZE))/(1024.*1024.);
+}
+
+inline void ProgressReporter::BeginOfRun( G4int numEvents )
+{
+#ifdef G4MULTITHREADED
+	G4RunManager::RMType type = G4RunManager::GetRunManager()->GetRunManagerType();
+	master = ( type == G4RunManager::masterRM );
+	worker = ( type == G4RunManager::workerRM );
+#endif
+	//numEvents is the total of the run: a worker processes only a part of it
+	eventsRequested = worker ? 0 : numEvents;
+	eventsDone = 0;
+	stepsDone = 0;
+	lastEvents = 0;
+	lastSteps = 0;
+	eventsToCheck = 1;
+	checkEvery = 1;
+	if ( verbose > 0 ) startTime = lastTime = lastCheck = WallTime();
+}
+
+inline void ProgressReporter::CheckTime()
+{
+	G4double now = WallTime();
+	//Adapt the number of events between two clock reads to have
+	//five to ten reads per interval
+	G4double sinceCheck = now - lastCheck;
+	lastCheck = now;
+	if ( sinceCheck < interval/10 ) checkEvery *= 2;
+	else if ( checkEvery > 1 && sinceCheck > interval/5 ) checkEvery /= 2;
+	eventsToCheck = checkEvery;
+	if ( now - lastTime >= interval ) Report(now);
+}
+
+inline void ProgressReporter::Report( G4double now )
+{
+	G4double total = now - startTime;
+	G4double elapsed = now - lastTime;
+	G4double average = total > 0 ? eventsDone/total : 0;
+	G4double current = elapsed > 0 ? (eventsDone-lastEvents)/elapsed : 0;
+
+	G4cout<<"Progress: "<<eventsDone;
+	if ( eventsRequested > 0 ) G4cout<<"/"<<eventsRequested;
+	G4cout<<" events in "<<static_cast<G4int>(total)<<" s, "
+		  <<average<<" ev/s (now "<<current<<" ev/s)";
+	if ( eventsRequested > eventsDone && average > 0 )
+		G4cout<<", ETA "<<static_cast<G4int>((eventsRequested-eventsDone)/average)<<" s";
+	if ( verbose > 1 )
+	{
+		if ( stepsDone > 0 && elapsed > 0 )
+			G4cout<<", "<<(stepsDone-lastSteps)/elapsed<<" steps/s";
+		G4double memory = ResidentMemory();
+		if ( memory > 0 ) G4cout<<", RSS "<<memory<<" MB";
+	}
+	G4cout<<G4endl;
+
+	lastTime = now;
+	lastEvents = eventsDone;
+	lastSteps = stepsDone;
+}
+
+inline void ProgressReporter::EndOfRun()
+{
+	if ( verbose == 0 ) return;
+#ifdef G4MULTITHREADED
+	//The master run holds the events of all the workers
+	if ( master ) eventsDone = G4RunManager::GetRunManager()->GetCurrentRun()->GetNumberOfEvent();
+#endif
+	G4double total = WallTime() - startTime;
+	G4cout<<"Progress: run done, "<<eventsDone<<" events in "<<total<<" s";
+	if ( total > 0 )
+	{
+		G4cout<<", "<<eventsDone/total<<" ev/s";
+		if ( stepsDone > 0 ) G4cout<<", "<<stepsDone/total<<" steps/s";
+	}
+	if ( verbose > 1 )
+	{
+		G4double memory = ResidentMemory();
+		if ( memory > 0 ) G4cout<<", RSS "<<memory<<" MB";
+	}
+	G4cout<<G4endl;
+}
+
+inline ProgressReporterMessenger::ProgressReporterMessenger(ProgressReporter* theReporter) :
+	reporter(theReporter)
+{
+	progressDir = new G4UIdirectory("/progress/");
+	progressDir->SetGuidance("periodic report of event rate and time to the end of the run");
+
+	verboseCmd = new G4UIcmdWithAnInteger("/progress/verbose",this);
+	verboseCmd->SetGuidance("0: no report, 1: event rate and ETA, 2: also step rate and memory");
+	verboseCmd->SetParameterName("level",false);
+	verboseCmd->SetRange("level>=0");
+	verboseCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	intervalCmd = new G4UIcmdWithADouble("/progress/interval",this);
+	intervalCmd->SetGuidance("Wall-clock seconds between two reports");
+	intervalCmd->SetParameterName("seconds",false);
+	intervalCmd->SetRange("seconds>0.");
+	intervalCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+inline ProgressReporterMessenger::~ProgressReporterMessenger()
+{
+	delete verboseCmd;
+	delete intervalCmd;
+	delete progressDir;
+}
+
+inline void ProgressReporterMessenger::SetNewValue(G4UIcommand* cmd,G4String newValue)
+{
+	if ( cmd == verboseCmd )
+		reporter->SetVerbose( verboseCmd->GetNewIntValue(newValue) );
+
+	if ( cmd == intervalCmd )
+		reporter->SetInterval( intervalCmd->GetNewDoubleValue(newValue) );
+}
+
+#endif /* PROGRESSREPORTER_HH_ */
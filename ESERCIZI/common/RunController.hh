@@ -0,0 +1,322 @@
+/*
+ * @file RunController.hh
+ *
+ * \brief RunController and RunControllerMessenger classes
+ *
+ * Precision driven run length controller, shared by the applications of
+ * the exercises: the header contains the whole implementation, add the
+ * directory ESERCIZI/common to the include path of the application.
+ */
+
+#ifndef RUNCONTROLLER_HH
+#define RUNCONTROLLER_HH 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4RunManager.hh"
+
+#include <vector>
+#include <cmath>
+#include <cfloat>
+
+class RunControllerMessenger;
+
+/*!
+ * \brief Stops a run once an observable reaches the requested precision.
+ *
+ * The application registers the observables it can provide and feeds,
+ * once per event, the value of the selected one with AddValue(), or
+ * its values with AddValues() when an event holds several independent
+ * samples (e.g. several primaries): all of them enter the statistic,
+ * the batches and the maximum still count events.
+ * Every \c batch events the relative uncertainty of the selected
+ * statistic (mean or rms of the per-event values) is evaluated and the
+ * run is aborted (softly, after the current event) when it is below the
+ * target or when the maximum number of events is reached.
+ * With a target of 0 (default) the controller is inactive and the run
+ * length is the one given to /run/beamOn.
+ *
+ * \sa RunControllerMessenger for the UI commands (/precision/)
+ */
+class RunController {
+public:
+  //! Statistic of the per-event values to converge
+  enum Statistic { kMean=0, kRMS=1 };
+
+  //! Singleton pattern
+  static RunController* GetInstance() {
+    static RunController controller;
+    return &controller;
+  }
+  ~RunController();
+
+  //! Make an observable selectable from UI, returns its index
+  G4int RegisterObservable( const G4String& name );
+  //! Index of the selected observable (order of registration)
+  G4int GetObservable() const { return observable; }
+  //! False if no target is set: no need to compute the observable
+  G4bool IsActive() const { return target > 0 || maxEvents > 0; }
+
+  void PrepareNewRun();
+  //! Add the value of the selected observable for this event
+  void AddValue( G4double value ) { AddValues( &value, 1 ); }
+  //! Add the n values of the selected observable for this event
+  void AddValues( const G4double* values, G4int n );
+  void EndOfRun();
+
+  //! \name set functions used by the messenger
+  //@{
+  void SetTarget( G4double val ) { target = val; }
+  void SetBatchSize( G4int val ) { batchSize = val; }
+  void SetMaxEvents( G4int val ) { maxEvents = val; }
+  void SetStatistic( Statistic val ) { statistic = val; }
+  G4bool SetObservable( const G4String& name );
+  //@}
+
+  //! Current value and relative uncertainty of the selected statistic
+  G4double GetValue() const;
+  G4double GetRelativeError() const;
+private:
+  //! Private constructor: part of singleton pattern
+  RunController();
+  RunControllerMessenger* messenger;
+
+  std::vector<G4String> observables;
+  G4int observable;
+  Statistic statistic;
+  G4double target;
+  G4int batchSize;
+  G4int maxEvents;
+
+  //! Events since the start of the run
+  G4int nEvents;
+  //! \name raw moments of the values
+  //@{
+  G4int nValues;
+  G4double sum1;
+  G4double sum2;
+  G4double sum3;
+  G4double sum4;
+  //@}
+  G4bool aborted;
+};
+
+/*!
+ * \brief This class provides the user interface to RunController
+ *
+ * \sa SetNewValue()
+ */
+class RunControllerMessenger : public G4UImessenger
+{
+public:
+  //! Constructor
+  RunControllerMessenger(RunController*);
+  //! Destructor
+  virtual ~RunControllerMessenger();
+  //! handle user commands
+  void SetNewValue(G4UIcommand*,G4String);
+  //! update list of observables provided by the application
+  void SetObservableCandidates(const G4String& candidates);
+private:
+  RunController*        controller;
+
+  G4UIdirectory*        precisionDir;
+  G4UIcmdWithADouble*   targetCmd;
+  G4UIcmdWithAnInteger* batchCmd;
+  G4UIcmdWithAnInteger* maxEventsCmd;
+  G4UIcmdWithAString*   statisticCmd;
+  G4UIcmdWithAString*   observableCmd;
+};
+
+inline RunController::RunController() :
+  observable(0),
+  statistic(kMean),
+  target(0),
+  batchSize(100),
+  maxEvents(0),
+  nEvents(0),
+  nValues(0),
+  sum1(0), sum2(0), sum3(0), sum4(0),
+  aborted(false)
+{
+  messenger = new RunControllerMessenger(this);
+}
+
+inline RunController::~RunController()
+{
+  delete messenger;
+}
+
+inline G4int RunController::RegisterObservable( const G4String& name )
+{
+  observables.push_back(name);
+  G4String candidates;
+  for ( size_t i = 0 ; i < observables.size() ; ++i )
+    candidates += observables[i] + " ";
+  messenger->SetObservableCandidates(candidates);
+  return observables.size()-1;
+}
+
+inline G4bool RunController::SetObservable( const G4String& name )
+{
+  for ( size_t i = 0 ; i < observables.size() ; ++i )
+    if ( observables[i] == name ) {
+      observable = i;
+      return true;
+    }
+  return false;
+}
+
+inline void RunController::PrepareNewRun()
+{
+  nEvents = 0;
+  nValues = 0;
+  sum1 = sum2 = sum3 = sum4 = 0;
+  aborted = false;
+}
+
+inline void RunController::AddValues( const G4double* values, G4int n )
+{
+  if ( aborted ) return;
+  ++nEvents;
+  for ( G4int i = 0 ; i < n ; ++i ) {
+    const G4double value = values[i];
+    const G4double v2 = value*value;
+    sum1 += value;
+    sum2 += v2;
+    sum3 += v2*value;
+    sum4 += v2*v2;
+  }
+  nValues += n;
+
+  //Checked once the whole event is in
+  G4bool stop = ( maxEvents > 0 && nEvents >= maxEvents );
+  if ( !stop && target > 0 && batchSize > 0 && nEvents % batchSize == 0 )
+    stop = ( GetRelativeError() < target );
+  if ( stop ) {
+    aborted = true;
+    G4cout<<"RunController: stopping run after "<<nEvents<<" events";
+    if ( nValues != nEvents ) G4cout<<" ("<<nValues<<" values)";
+    G4cout<<", "
+          <<( statistic == kMean ? "mean" : "rms" )<<" of "
+          <<observables[observable]<<" = "<<GetValue()
+          <<" +- "<<GetRelativeError()*100<<" %"<<G4endl;
+    //Soft abort: the current event is completed
+    G4RunManager::GetRunManager()->AbortRun(true);
+  }
+}
+
+inline G4double RunController::GetValue() const
+{
+  if ( nValues == 0 ) return 0;
+  const G4double mean = sum1/nValues;
+  if ( statistic == kMean ) return mean;
+  const G4double var = sum2/nValues - mean*mean;
+  return var > 0 ? std::sqrt(var) : 0;
+}
+
+inline G4double RunController::GetRelativeError() const
+{
+  if ( nValues < 2 ) return DBL_MAX;
+  const G4double n = nValues;
+  const G4double mean = sum1/n;
+  const G4double var = sum2/n - mean*mean;
+  if ( var <= 0 ) return ( statistic == kMean && mean != 0 ) ? 0 : DBL_MAX;
+  if ( statistic == kMean ) {
+    if ( mean == 0 ) return DBL_MAX;
+    return std::sqrt(var/(n-1))/std::fabs(mean);
+  }
+  // rms: error propagated from the variance of the sample variance,
+  // var(s^2) = (m4 - s^4)/n with m4 the 4th central moment
+  const G4double m4 = sum4/n - 4*mean*sum3/n + 6*mean*mean*sum2/n
+    - 3*mean*mean*mean*mean;
+  const G4double varS2 = ( m4 - var*var )/n;
+  if ( varS2 <= 0 ) return 0;
+  return 0.5*std::sqrt(varS2)/var;
+}
+
+inline void RunController::EndOfRun()
+{
+  if ( !IsActive() || nValues == 0 ) return;
+  G4cout<<"  RunController: "<<( statistic == kMean ? "mean" : "rms" )
+        <<" of "<<observables[observable]<<" = "<<GetValue()
+        <<", relative uncertainty "<<GetRelativeError()
+        <<" (target "<<target<<")"
+        <<( aborted ? ", run stopped early" : "" )<<G4endl;
+}
+
+inline RunControllerMessenger::RunControllerMessenger(RunController* ctrl) :
+  controller(ctrl)
+{
+  precisionDir = new G4UIdirectory("/precision/");
+  precisionDir->SetGuidance("stop the run when an observable has converged");
+
+  targetCmd = new G4UIcmdWithADouble("/precision/target",this);
+  targetCmd->SetGuidance("Relative uncertainty at which the run is stopped.");
+  targetCmd->SetGuidance("0 disables the precision check.");
+  targetCmd->SetParameterName("target",false);
+  targetCmd->SetRange("target>=0.");
+  targetCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  batchCmd = new G4UIcmdWithAnInteger("/precision/batch",this);
+  batchCmd->SetGuidance("Number of events between two precision checks");
+  batchCmd->SetParameterName("batch",false);
+  batchCmd->SetRange("batch>0");
+  batchCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  maxEventsCmd = new G4UIcmdWithAnInteger("/precision/maxEvents",this);
+  maxEventsCmd->SetGuidance("Maximum number of events of a run (0: as given to /run/beamOn)");
+  maxEventsCmd->SetParameterName("maxEvents",false);
+  maxEventsCmd->SetRange("maxEvents>=0");
+  maxEventsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  statisticCmd = new G4UIcmdWithAString("/precision/statistic",this);
+  statisticCmd->SetGuidance("Statistic of the observable to converge: mean or rms");
+  statisticCmd->SetParameterName("statistic",false);
+  statisticCmd->SetCandidates("mean rms");
+  statisticCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  observableCmd = new G4UIcmdWithAString("/precision/observable",this);
+  observableCmd->SetGuidance("Per-event observable used for the precision check");
+  observableCmd->SetParameterName("observable",false);
+  observableCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+inline RunControllerMessenger::~RunControllerMessenger()
+{
+  delete targetCmd;
+  delete batchCmd;
+  delete maxEventsCmd;
+  delete statisticCmd;
+  delete observableCmd;
+  delete precisionDir;
+}
+
+inline void RunControllerMessenger::SetObservableCandidates(const G4String& candidates)
+{
+  observableCmd->SetCandidates(candidates);
+}
+
+inline void RunControllerMessenger::SetNewValue(G4UIcommand* cmd,G4String newValue)
+{
+  if ( cmd == targetCmd )
+    controller->SetTarget( targetCmd->GetNewDoubleValue(newValue) );
+
+  if ( cmd == batchCmd )
+    controller->SetBatchSize( batchCmd->GetNewIntValue(newValue) );
+
+  if ( cmd == maxEventsCmd )
+    controller->SetMaxEvents( maxEventsCmd->GetNewIntValue(newValue) );
+
+  if ( cmd == statisticCmd )
+    controller->SetStatistic( newValue == "rms" ? RunController::kRMS : RunController::kMean );
+
+  if ( cmd == observableCmd )
+    controller->SetObservable(newValue);
+}
+
+#endif /* RUNCONTROLLER_HH */
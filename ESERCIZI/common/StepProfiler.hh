@@ -0,0 +1,347 @@
+/*
+ * @file StepProfiler.hh
+ *
+ * \brief StepProfiler and StepProfilerMessenger classes
+ *
+ * Shared by all the applications of the exercises: the header contains
+ * the whole implementation, add the directory ESERCIZI/common to the
+ * include path of the application.
+ */
+
+#ifndef STEPPROFILER_HH_
+#define STEPPROFILER_HH_
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4StepPoint.hh"
+#include "G4VProcess.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+
+#include <time.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <vector>
+
+//Geant4 versions before 10.0 have no thread local storage
+#ifndef G4ThreadLocal
+#define G4ThreadLocal
+#endif
+
+class StepProfilerMessenger;
+
+/*!
+ * \brief Counts steps, tracks and CPU time by volume, particle and process.
+ *
+ * When enabled (/profile/enable) every step is added to a table with one
+ * entry per combination of:
+ *  - logical volume of the pre-step point
+ *  - particle type
+ *  - process that limited the step
+ * Each entry counts the number of steps, the number of tracks (a track is
+ * counted in the entry of its first step) and the CPU time of the thread
+ * spent since the previous step, which is attributed to this step.
+ * At the end of the run the top entries are printed, sorted by CPU time or
+ * number of steps, followed by the totals per volume, particle and process.
+ * The full table can be written to a CSV file.
+ *
+ * Create the instance in the constructor of the RunAction, so that the
+ * /profile/ commands exist before the first run.
+ * When disabled the SteppingAction only pays one test per step.
+ * The class is designed as a singleton, with one instance per thread:
+ * in a multithreaded run each worker reports on its own events.
+ */
+class StepProfiler {
+public:
+	//! Singleton pattern
+	static StepProfiler* GetInstance() {
+		static G4ThreadLocal StepProfiler* singleton = 0;
+		if ( singleton == 0 ) singleton = new StepProfiler();
+		return singleton;
+	}
+	//! destructor
+	virtual ~StepProfiler();
+	//! True if steps have to be added
+	G4bool IsEnabled() const { return enabled; }
+	//! Reset the table
+	void BeginOfRun();
+	//! Add a step (called by SteppingAction)
+	void AddStep( const G4Step* aStep );
+	//! Print the report and write the CSV file
+	void EndOfRun();
+
+	//! \name set functions used by the messenger
+	//@{
+	void SetEnabled( G4bool val ) { enabled = val; }
+	void SetTopN( G4int val ) { topN = val; }
+	void SetSortByTime( G4bool val ) { sortByTime = val; }
+	void SetCSVFile( const G4String& name ) { csvFile = name; }
+	//@}
+
+	//! Identifies an entry of the table
+	struct Key {
+		const G4LogicalVolume* volume;
+		const G4ParticleDefinition* particle;
+		const G4VProcess* process;
+		bool operator<( const Key& other ) const {
+			if ( volume != other.volume ) return volume < other.volume;
+			if ( particle != other.particle ) return particle < other.particle;
+			return process < other.process;
+		}
+	};
+	//! Content of an entry of the table
+	struct Counters {
+		Counters() : steps(0), tracks(0), cpuTime(0) {}
+		G4double steps;
+		G4double tracks;
+		G4double cpuTime;	//!< seconds
+		void Add( const Counters& other ) {
+			steps += other.steps; tracks += other.tracks; cpuTime += other.cpuTime;
+		}
+	};
+private:
+	//! Private construtor: part of singleton pattern
+	StepProfiler();
+	StepProfilerMessenger* messenger;
+
+	typedef std::pair<Key,Counters> Entry;
+	//! Sort in decreasing order of CPU time
+	static bool MoreTime( const Entry& a, const Entry& b ) { return a.second.cpuTime > b.second.cpuTime; }
+	//! Sort in decreasing order of steps
+	static bool MoreSteps( const Entry& a, const Entry& b ) { return a.second.steps > b.second.steps; }
+	//! \name names used in the report
+	//@{
+	static G4String VolumeName( const G4LogicalVolume* volume )
+	{ return volume ? volume->GetName() : G4String("OutOfWorld"); }
+	static G4String ParticleName( const G4ParticleDefinition* particle )
+	{ return particle ? particle->GetParticleName() : G4String("unknown"); }
+	static G4String ProcessName( const G4VProcess* process )
+	{ return process ? process->GetProcessName() : G4String("none"); }
+	//@}
+
+	//! CPU time used by this thread, in seconds
+	static G4double ThreadCPUTime();
+	//! Print the totals grouped by one of the fields of the key
+	void PrintGrouped( const G4String& title, G4int field, G4double totalTime ) const;
+	//! Write all the entries to csvFile
+	void WriteCSV() const;
+
+	G4bool enabled;
+	G4int topN;
+	G4bool sortByTime;
+	G4String csvFile;
+
+	std::map<Key,Counters> table;
+	//! Entry of the previous step: consecutive steps often share it
+	Key lastKey;
+	Counters* lastCounters;
+	//! CPU time at the previous step
+	G4double lastTime;
+};
+
+/*!
+ * \brief This class provides the user interface to StepProfiler
+ *
+ * \sa SetNewValue()
+ */
+class StepProfilerMessenger : public G4UImessenger
+{
+public:
+	//! Constructor
+	StepProfilerMessenger(StepProfiler*);
+	//! Destructor
+	virtual ~StepProfilerMessenger();
+	//! handle user commands
+	void SetNewValue(G4UIcommand*,G4String);
+private:
+	StepProfiler*			profiler;
+
+	G4UIdirectory*			profileDir;
+	G4UIcmdWithABool*		enableCmd;
+	G4UIcmdWithAnInteger*	topCmd;
+	G4UIcmdWithAString*		sortCmd;
+	G4UIcmdWithAString*		csvCmd;
+};
+
+inline StepProfiler::StepProfiler() :
+	enabled(false),
+	topN(20),
+	sortByTime(true),
+	lastCounters(0),
+	lastTime(0)
+{
+	messenger = new StepProfilerMessenger(this);
+}
+
+inline StepProfiler::~StepProfiler()
+{
+	delete messenger;
+}
+
+inline G4double StepProfiler::ThreadCPUTime()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID,&ts);
+	return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+inline void StepProfiler::BeginOfRun()
+{
+	table.clear();
+	lastCounters = 0;
+	if ( enabled ) lastTime = ThreadCPUTime();
+}
+
+inline void StepProfiler::AddStep( const G4Step* aStep )
+{
+	G4double now = ThreadCPUTime();
+	const G4StepPoint* pre = aStep->GetPreStepPoint();
+	Key key;
+	key.volume = pre->GetPhysicalVolume() ? pre->GetPhysicalVolume()->GetLogicalVolume() : 0;
+	key.particle = aStep->GetTrack()->GetDefinition();
+	key.process = aStep->GetPostStepPoint()->GetProcessDefinedStep();
+	//Map lookup only when the entry changes
+	if ( lastCounters == 0 || key < lastKey || lastKey < key )
+	{
+		lastKey = key;
+		lastCounters = &table[key];
+	}
+	lastCounters->steps += 1;
+	if ( aStep->GetTrack()->GetCurrentStepNumber() == 1 ) lastCounters->tracks += 1;
+	lastCounters->cpuTime += now - lastTime;
+	lastTime = now;
+}
+
+inline void StepProfiler::EndOfRun()
+{
+	if ( !enabled || table.empty() ) return;
+	std::vector<Entry> entries( table.begin() , table.end() );
+	std::sort( entries.begin() , entries.end() , sortByTime ? MoreTime : MoreSteps );
+	Counters total;
+	for ( size_t i = 0 ; i < entries.size() ; ++i ) total.Add( entries[i].second );
+
+	G4cout<<"================="<<G4endl;
+	G4cout<<"Step profile: "<<total.steps<<" steps, "<<total.tracks<<" tracks, "
+		  <<total.cpuTime<<" s CPU in "<<entries.size()<<" (volume,particle,process) entries"<<G4endl;
+	G4cout<<"\t Top "<<std::min<size_t>(topN,entries.size())<<" sorted by "
+		  <<(sortByTime ? "CPU time" : "steps")<<":"<<G4endl;
+	for ( size_t i = 0 ; i < entries.size() && i < static_cast<size_t>(topN) ; ++i )
+	{
+		const Counters& c = entries[i].second;
+		G4cout<<"\t "<<VolumeName(entries[i].first.volume)
+			  <<" / "<<ParticleName(entries[i].first.particle)
+			  <<" / "<<ProcessName(entries[i].first.process)
+			  <<": steps "<<c.steps<<" tracks "<<c.tracks
+			  <<" CPU "<<c.cpuTime<<" s ("<<(total.cpuTime > 0 ? 100*c.cpuTime/total.cpuTime : 0)<<" %)"
+			  <<G4endl;
+	}
+	PrintGrouped("volume",0,total.cpuTime);
+	PrintGrouped("particle",1,total.cpuTime);
+	PrintGrouped("process",2,total.cpuTime);
+	G4cout<<"================="<<G4endl;
+	if ( !csvFile.empty() ) WriteCSV();
+}
+
+inline void StepProfiler::PrintGrouped( const G4String& title, G4int field, G4double totalTime ) const
+{
+	std::map<G4String,Counters> groups;
+	std::map<Key,Counters>::const_iterator it = table.begin();
+	for ( ; it != table.end() ; ++it )
+	{
+		G4String name = field == 0 ? VolumeName(it->first.volume) :
+						field == 1 ? ParticleName(it->first.particle) :
+									 ProcessName(it->first.process);
+		groups[name].Add(it->second);
+	}
+	G4cout<<"\t By "<<title<<":"<<G4endl;
+	std::map<G4String,Counters>::const_iterator group = groups.begin();
+	for ( ; group != groups.end() ; ++group )
+	{
+		const Counters& c = group->second;
+		G4cout<<"\t\t "<<group->first<<": steps "<<c.steps<<" tracks "<<c.tracks
+			  <<" CPU "<<c.cpuTime<<" s ("<<(totalTime > 0 ? 100*c.cpuTime/totalTime : 0)<<" %)"<<G4endl;
+	}
+}
+
+inline void StepProfiler::WriteCSV() const
+{
+	std::ofstream out(csvFile.c_str());
+	if ( !out )
+	{
+		G4cerr<<"StepProfiler: cannot write "<<csvFile<<G4endl;
+		return;
+	}
+	out<<"volume,particle,process,steps,tracks,cpu_s"<<std::endl;
+	std::map<Key,Counters>::const_iterator it = table.begin();
+	for ( ; it != table.end() ; ++it )
+	{
+		out<<VolumeName(it->first.volume)<<","<<ParticleName(it->first.particle)<<","
+		   <<ProcessName(it->first.process)<<","<<it->second.steps<<","
+		   <<it->second.tracks<<","<<it->second.cpuTime<<std::endl;
+	}
+	G4cout<<"StepProfiler: table written to "<<csvFile<<G4endl;
+}
+
+inline StepProfilerMessenger::StepProfilerMessenger(StepProfiler* theProfiler) :
+	profiler(theProfiler)
+{
+	profileDir = new G4UIdirectory("/profile/");
+	profileDir->SetGuidance("steps, tracks and CPU time by volume, particle and process");
+
+	enableCmd = new G4UIcmdWithABool("/profile/enable",this);
+	enableCmd->SetGuidance("Profile the next runs");
+	enableCmd->SetParameterName("enable",true);
+	enableCmd->SetDefaultValue(true);
+	enableCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	topCmd = new G4UIcmdWithAnInteger("/profile/top",this);
+	topCmd->SetGuidance("Number of entries printed at the end of the run");
+	topCmd->SetParameterName("N",false);
+	topCmd->SetRange("N>0");
+	topCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	sortCmd = new G4UIcmdWithAString("/profile/sortBy",this);
+	sortCmd->SetGuidance("Sort the report by CPU time or by number of steps");
+	sortCmd->SetParameterName("key",false);
+	sortCmd->SetCandidates("time steps");
+	sortCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	csvCmd = new G4UIcmdWithAString("/profile/csv",this);
+	csvCmd->SetGuidance("Write the full table to this CSV file at the end of the run");
+	csvCmd->SetParameterName("file",false);
+	csvCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+inline StepProfilerMessenger::~StepProfilerMessenger()
+{
+	delete enableCmd;
+	delete topCmd;
+	delete sortCmd;
+	delete csvCmd;
+	delete profileDir;
+}
+
+inline void StepProfilerMessenger::SetNewValue(G4UIcommand* cmd,G4String newValue)
+{
+	if ( cmd == enableCmd )
+		profiler->SetEnabled( enableCmd->GetNewBoolValue(newValue) );
+
+	if ( cmd == topCmd )
+		profiler->SetTopN( topCmd->GetNewIntValue(newValue) );
+
+	if ( cmd == sortCmd )
+		profiler->SetSortByTime( newValue == "time" );
+
+	if ( cmd == csvCmd )
+		profiler->SetCSVFile(newValue);
+}
+
+#endif /* STEPPROFILER_HH_ */
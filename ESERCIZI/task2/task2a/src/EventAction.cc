@@ -17,6 +17,7 @@
 #include "G4SDManager.hh"
 #include "G4DigiManager.hh"
 #include "G4Event.hh"
+#include "ProgressReporter.hh"
 
 EventAction::EventAction() :
 	rootSaver(0),
@@ -31,12 +32,8 @@ EventAction::EventAction() :
 }
 
 
-void EventAction::BeginOfEventAction(const G4Event* anEvent )
+void EventAction::BeginOfEventAction(const G4Event* /*anEvent*/ )
 {
-	if ( anEvent->GetEventID() % 1000 == 0 )
-	{
-		G4cout<<"Starting Event: "<<anEvent->GetEventID()<<G4endl;
-	}
 	//Retrieve the ID for the hit collection
 	if ( hitsCollID == -1 )
 	{
@@ -46,6 +43,7 @@ void EventAction::BeginOfEventAction(const G4Event* anEvent )
 }
 void EventAction::EndOfEventAction(const G4Event* anEvent)
 {
+	ProgressReporter::GetInstance()->EndOfEvent();
 	//Digitize!!
 	G4DigiManager * digiManager = G4DigiManager::GetDMpointer();
 	SiDigitizer* digiModule = static_cast<SiDigitizer*>( digiManager->FindDigitizerModule("SiDigitizer") );
@@ -11,15 +11,19 @@
 #include "RunAction.hh"
 #include "EventAction.hh"
 #include "G4Run.hh"
+#include "ProgressReporter.hh"
 
 RunAction::RunAction(EventAction* theEventAction ) :
 	eventAction(theEventAction)
 {
+	//Create the reporter now so that its UI commands are available
+	ProgressReporter::GetInstance();
 	eventAction->SetRootSaver( &saver );
 }
 
 void RunAction::BeginOfRunAction(const G4Run* aRun )
 {
+	ProgressReporter::GetInstance()->BeginOfRun(aRun->GetNumberOfEventToBeProcessed());
 	G4cout<<"Starting Run: "<<aRun->GetRunID()<<G4endl;
 	//For each run a new TTree is created, with default names
 	saver.CreateTree();
@@ -27,5 +31,6 @@ void RunAction::BeginOfRunAction(const G4Run* aRun )
 
 void RunAction::EndOfRunAction( const G4Run* /*aRun*/ )
 {
+	ProgressReporter::GetInstance()->EndOfRun();
 	saver.CloseTree();
 }
@@ -6,6 +6,8 @@
 
 #include "SteppingAction.hh"
 #include "G4Step.hh"
+#include "ProgressReporter.hh"
+#include "StepProfiler.hh"
 #include "G4VTouchable.hh"
 #include "Analysis.hh"
 #include "Randomize.hh"
@@ -18,6 +20,9 @@ SteppingAction::~SteppingAction()
 
 void SteppingAction::UserSteppingAction( const G4Step * theStep ) 
 {
+  ProgressReporter::GetInstance()->AddStep();
+  StepProfiler* profiler = StepProfiler::GetInstance();
+  if ( profiler->IsEnabled() ) profiler->AddStep(theStep);
   // Check energy deposition
   G4double edep = theStep->GetTotalEnergyDeposit();
   if(edep == 0.0) { return; }
@@ -9,11 +9,14 @@
  */
 
 #include "G4VUserPrimaryGeneratorAction.hh"
+#include "globals.hh"
 
 #include <fstream>
 
 
 class G4VPrimaryGenerator;
+class G4PrimaryParticle;
+class PrimaryGeneratorMessenger;
  
 /*!
 \brief This mandatory user class provides the primary particle generator
@@ -22,22 +25,50 @@ Geant4 provides a number of predefined primary particle generator, to be utilise
  - G4ParticleGun
  - G4GeneralParticleSource
 
+Optionally the decay proper time of the primaries is sampled from a biased
+distribution (\sa BiasDecayTime). The primary receives the likelihood ratio
+as statistical weight, which is inherited by the decay products and used
+by Analysis when filling the histograms.
+
 \sa GeneratePrimaries()
  */
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
 public:
+  //! Decay time biasing modes
+  enum DecayBiasMode {
+    kNoBias=0,      //!< analog decay
+    kStretch=1,     //!< lifetime multiplied by stretch factor
+    kWindow=2       //!< decay forced in [windowMin,windowMax]
+  };
   //! constructor
   PrimaryGeneratorAction();
   //! destructor
   ~PrimaryGeneratorAction();
   //! defines primary particles (mandatory)
   void GeneratePrimaries(G4Event*);
+
+  //! \name decay biasing set & get functions
+  //@{
+  void SetDecayBiasMode( DecayBiasMode mode ) { biasMode = mode; }
+  DecayBiasMode GetDecayBiasMode() const { return biasMode; }
+  void SetLifetimeStretch( G4double factor ) { stretchFactor = factor; }
+  G4double GetLifetimeStretch() const { return stretchFactor; }
+  void SetDecayWindow( G4double tmin , G4double tmax ) { windowMin = tmin; windowMax = tmax; }
+  //@}
 private:  
   G4VPrimaryGenerator* InitializeGPS();
+  //! Pre-assign a biased decay proper time and multiply the weight
+  void BiasDecayTime( G4PrimaryParticle* primary );
 private:
   G4VPrimaryGenerator* gun;
   std::ofstream * outfile;
+  PrimaryGeneratorMessenger* messenger;
+
+  DecayBiasMode biasMode;
+  G4double stretchFactor;
+  G4double windowMin;
+  G4double windowMax;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,63 @@
+// $Id:$
+
+#ifndef PrimaryGeneratorMessenger_h
+#define PrimaryGeneratorMessenger_h 1
+
+/**
+ * @file
+ * @brief defines class PrimaryGeneratorMessenger
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class PrimaryGeneratorAction;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/*!
+\brief This class provides the user interface to the decay time biasing
+of PrimaryGeneratorAction
+
+It allows for
+ - selection of the biasing mode (none, stretch, window)
+ - lifetime stretch factor
+ - decay time window
+
+\sa SetNewValue()
+*/
+class PrimaryGeneratorMessenger: public G4UImessenger
+{
+public:
+  //! Constructor
+  PrimaryGeneratorMessenger(PrimaryGeneratorAction* );
+  //! Destructor
+  ~PrimaryGeneratorMessenger();
+    
+  //! handle user commands
+  void SetNewValue(G4UIcommand*, G4String);
+    
+private:
+  
+  PrimaryGeneratorAction*    generator;
+    
+  G4UIdirectory*             biasDir;
+  G4UIcmdWithAString*        modeCmd;
+  G4UIcmdWithADouble*        stretchCmd;
+  G4UIcmdWithADoubleAndUnit* windowMinCmd;
+  G4UIcmdWithADoubleAndUnit* windowMaxCmd;
+
+  G4double                   windowMin;
+  G4double                   windowMax;
+};
+ 
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
+
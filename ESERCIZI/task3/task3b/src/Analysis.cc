@@ -37,12 +37,14 @@ void Analysis::AddTrack( const G4Track * aTrack )
     const G4ThreeVector & pos = aTrack->GetPosition();
     const G4ThreeVector & mom = aTrack->GetMomentumDirection();
     G4double time = aTrack->GetGlobalTime();
+    // weight is 1 unless decay time biasing is active (see /bias/mode)
+    G4double weight = aTrack->GetWeight();
 
 
-    histos[fDecayPosZ]->Fill(pos.z()/m);
-    histos[fDecayTime]->Fill(time/millisecond);
-    if (mom.z()>0) histos[fDecayTimeForward]->Fill(time/millisecond);
-    else histos[fDecayTimeBackward]->Fill(time/millisecond);
+    histos[fDecayPosZ]->Fill(pos.z()/m,weight);
+    histos[fDecayTime]->Fill(time/millisecond,weight);
+    if (mom.z()>0) histos[fDecayTimeForward]->Fill(time/millisecond,weight);
+    else histos[fDecayTimeBackward]->Fill(time/millisecond,weight);
   }
 }
 
@@ -60,6 +62,8 @@ void Analysis::PrepareNewRun(const G4Run* /*aRun*/ )
 	thisRunTotSecondaries = 0;
 
 	TH1D *h=0;
+	// store sum of squared weights: needed for errors with biased decays
+	TH1::SetDefaultSumw2(true);
 	// create Histograms
 	histos.push_back(h=new TH1D("decayPos","Z Position of Decay",100,0.8*m,(0.8+2.24)*m) );
 	h->GetYaxis()->SetTitle("events");
@@ -5,29 +5,79 @@
  */
 
 #include "PrimaryGeneratorAction.hh"
-#include "PrimaryGeneratorAction.hh"
+#include "PrimaryGeneratorMessenger.hh"
 
 #include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
 #include "G4ParticleGun.hh"
 #include "G4GeneralParticleSource.hh"
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
+#include "Randomize.hh"
+
+#include <cmath>
 
 
 PrimaryGeneratorAction::PrimaryGeneratorAction()
-  : outfile(0)
+  : outfile(0),
+    biasMode(kNoBias),
+    stretchFactor(1.),
+    windowMin(0.),
+    windowMax(20.*microsecond)
 {
   gun = InitializeGPS();
-  
+  messenger = new PrimaryGeneratorMessenger(this);
 }
 
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 { 
   gun->GeneratePrimaryVertex(anEvent);
+
+  if ( biasMode == kNoBias ) return;
+  for ( G4int iv = 0 ; iv < anEvent->GetNumberOfPrimaryVertex() ; ++iv )
+  {
+    G4PrimaryParticle* primary = anEvent->GetPrimaryVertex(iv)->GetPrimary();
+    for ( ; primary ; primary = primary->GetNext() )
+      BiasDecayTime(primary);
+  }
+}
+
+void PrimaryGeneratorAction::BiasDecayTime( G4PrimaryParticle* primary )
+{
+  // The proper time assigned to the primary is used by G4Decay (both in
+  // flight and at rest) instead of sampling it from the lifetime.
+  // The weight is the ratio between the analog pdf exp(-t/tau)/tau and
+  // the biased pdf, so that weighted histograms are unbiased.
+  const G4ParticleDefinition* particle = primary->GetG4code();
+  if ( !particle || particle->GetPDGStable() ) return;
+  const G4double tau = particle->GetPDGLifeTime();
+  if ( tau <= 0. ) return;
+
+  G4double properTime = 0;
+  G4double weight = 1.;
+  if ( biasMode == kStretch )
+  {
+    const G4double biasedTau = stretchFactor*tau;
+    properTime = -biasedTau*std::log( G4UniformRand() );
+    weight = stretchFactor*std::exp( properTime/biasedTau - properTime/tau );
+  }
+  else if ( biasMode == kWindow )
+  {
+    // truncated exponential in [windowMin,windowMax]:
+    // weight is the analog probability to decay in the window
+    const G4double pMin = std::exp( -windowMin/tau );
+    const G4double pMax = std::exp( -windowMax/tau );
+    weight = pMin - pMax;
+    properTime = -tau*std::log( pMin - G4UniformRand()*weight );
+  }
+  primary->SetProperTime(properTime);
+  primary->SetWeight( primary->GetWeight()*weight );
 }
 
 PrimaryGeneratorAction::~PrimaryGeneratorAction()
 {
+  delete messenger;
   delete gun;
 }
 
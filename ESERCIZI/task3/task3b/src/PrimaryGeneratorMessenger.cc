@@ -0,0 +1,92 @@
+// $Id:$
+/**
+ * @file
+ * @brief Implements class PrimaryGeneratorMessenger.
+ */
+
+#include "PrimaryGeneratorMessenger.hh"
+#include "PrimaryGeneratorAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+PrimaryGeneratorMessenger::PrimaryGeneratorMessenger(PrimaryGeneratorAction * gen)
+:generator(gen),
+ windowMin(0.),
+ windowMax(20.*microsecond)
+{ 
+  biasDir = new G4UIdirectory("/bias/");
+  biasDir->SetGuidance("decay time biasing of the primary particles");
+
+  modeCmd = new G4UIcmdWithAString("/bias/mode",this);
+  modeCmd->SetGuidance("Select decay time biasing mode.");
+  modeCmd->SetGuidance("  none    : analog decay");
+  modeCmd->SetGuidance("  stretch : lifetime multiplied by /bias/stretch");
+  modeCmd->SetGuidance("  window  : decay forced between /bias/windowMin and /bias/windowMax");
+  modeCmd->SetGuidance("Histograms are filled with the resulting track weight.");
+  modeCmd->SetParameterName("mode",false);
+  modeCmd->SetCandidates("none stretch window");
+  modeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  stretchCmd = new G4UIcmdWithADouble("/bias/stretch",this);
+  stretchCmd->SetGuidance("Define lifetime stretch factor (>1 enhances late decays)");
+  stretchCmd->SetParameterName("stretch",false);
+  stretchCmd->SetRange("stretch>0.");
+  stretchCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  windowMinCmd = new G4UIcmdWithADoubleAndUnit("/bias/windowMin",this);
+  windowMinCmd->SetGuidance("Define lower edge of the forced decay proper time window");
+  windowMinCmd->SetParameterName("windowMin",false);
+  windowMinCmd->SetRange("windowMin>=0.");
+  windowMinCmd->SetUnitCategory("Time");
+  windowMinCmd->SetDefaultUnit("microsecond");
+  windowMinCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  windowMaxCmd = new G4UIcmdWithADoubleAndUnit("/bias/windowMax",this);
+  windowMaxCmd->SetGuidance("Define upper edge of the forced decay proper time window");
+  windowMaxCmd->SetParameterName("windowMax",false);
+  windowMaxCmd->SetRange("windowMax>0.");
+  windowMaxCmd->SetUnitCategory("Time");
+  windowMaxCmd->SetDefaultUnit("microsecond");
+  windowMaxCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+PrimaryGeneratorMessenger::~PrimaryGeneratorMessenger()
+{
+  delete modeCmd;
+  delete stretchCmd;
+  delete windowMinCmd;
+  delete windowMaxCmd;
+
+  delete biasDir;  
+}
+
+void PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{
+  if ( command == modeCmd ) {
+    if ( newValue == "stretch" )
+      generator->SetDecayBiasMode(PrimaryGeneratorAction::kStretch);
+    else if ( newValue == "window" )
+      generator->SetDecayBiasMode(PrimaryGeneratorAction::kWindow);
+    else
+      generator->SetDecayBiasMode(PrimaryGeneratorAction::kNoBias);
+  }
+
+  if ( command == stretchCmd )
+    generator->SetLifetimeStretch( stretchCmd->GetNewDoubleValue(newValue) );
+
+  if ( command == windowMinCmd || command == windowMaxCmd ) {
+    if ( command == windowMinCmd ) windowMin = windowMinCmd->GetNewDoubleValue(newValue);
+    else windowMax = windowMaxCmd->GetNewDoubleValue(newValue);
+    if ( windowMax <= windowMin ) {
+      G4cerr<<"PrimaryGeneratorMessenger: empty decay window ["
+            <<windowMin/microsecond<<","<<windowMax/microsecond
+            <<"] us, ignored"<<G4endl;
+      return;
+    }
+    generator->SetDecayWindow(windowMin,windowMax);
+  }
+}
+
@@ -7,6 +7,8 @@
 
 #include "SteppingAction.hh"
 #include "G4Step.hh"
+#include "ProgressReporter.hh"
+#include "StepProfiler.hh"
 
 #include "G4VTouchable.hh"
 
@@ -23,6 +25,9 @@ SteppingAction::~SteppingAction()
 }
 
 void SteppingAction::UserSteppingAction( const G4Step * theStep ) {
+	ProgressReporter::GetInstance()->AddStep();
+	StepProfiler* profiler = StepProfiler::GetInstance();
+	if ( profiler->IsEnabled() ) profiler->AddStep(theStep);
 	//Check if this is the first step of this event,
 	//in this case print out info and prepare for next event
 	//Ask the stepping manager if this is the first step of this
@@ -70,6 +70,10 @@ private:
   TH1D*     m_ROOT_histo2;
   */
   std::vector<TH1*> histos;
+  //! observables registered in RunController
+  G4int obsEnergyTotal;
+  G4int obsEnergyCentral;
+
   enum {
     fEnergyTotal=0,
     fEnergyCentral=1,
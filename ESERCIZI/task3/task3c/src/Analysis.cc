@@ -5,6 +5,7 @@
  */
 
 #include "Analysis.hh"
+#include "RunController.hh"
 #include "G4UnitsTable.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4Event.hh"
@@ -34,6 +35,10 @@ Analysis::~Analysis()
 
 Analysis::Analysis() 
 {
+  //normalized energies can be used to stop the run (/precision/)
+  RunController* controller = RunController::GetInstance();
+  obsEnergyTotal = controller->RegisterObservable("etot");
+  obsEnergyCentral = controller->RegisterObservable("e0");
 }
 
 void Analysis::PrepareNewEvent(const G4Event* /*anEvent*/)
@@ -56,6 +61,8 @@ void Analysis::PrepareNewRun(const G4Run* /*aRun*/ )
   n_electron = 0;
   n_positron = 0;
 
+  RunController::GetInstance()->PrepareNewRun();
+
 #ifdef G4ANALYSIS_USE_ROOT
 
   // create histograms
@@ -82,6 +89,14 @@ void Analysis::EndOfEvent(const G4Event* /*anEvent*/)
   thisRunTotEM2 += thisEventTotEM*thisEventTotEM;
   thisRunCentralEM += thisEventCentralEM;
   thisRunCentralEM2 += thisEventCentralEM*thisEventCentralEM;
+
+  RunController* controller = RunController::GetInstance();
+  if ( controller->IsActive() ) {
+    if ( controller->GetObservable() == obsEnergyCentral )
+      controller->AddValue(thisEventCentralEM/beamEnergy);
+    else
+      controller->AddValue(thisEventTotEM/beamEnergy);
+  }
   
   //Uncomment these lines for more verbosity:
   //G4cout<<"Event: "<< anEvent->GetEventID() <<" Energy in EM calo: "
@@ -121,6 +136,7 @@ void Analysis::EndOfRun(const G4Run* aRun)
   G4cout<<"  RMS: "<<rms<<G4endl;
   G4cout<<"  Ratio of central crystal to total:    "<<thisRunCentralEM/thisRunTotEM
 	<<G4endl;
+  RunController::GetInstance()->EndOfRun();
   G4cout<<"================="<<G4endl;
 
   // Writing and closing the ROOT file
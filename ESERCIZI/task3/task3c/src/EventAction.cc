@@ -6,6 +6,7 @@
 
 #include "EventAction.hh"
 #include "G4Event.hh"
+#include "ProgressReporter.hh"
 #include "Analysis.hh"
 
 EventAction::EventAction()
@@ -16,15 +17,12 @@ EventAction::~EventAction()
 
 void EventAction::BeginOfEventAction(const G4Event* anEvent )
 {
-  if ( anEvent->GetEventID() % 1000 == 0 )
-    {
-      G4cout<<"Starting Event: "<<anEvent->GetEventID()<<G4endl;
-    }
   Analysis::GetInstance()->PrepareNewEvent(anEvent);
 }
 
 void EventAction::EndOfEventAction(const G4Event* anEvent)
 {
+  ProgressReporter::GetInstance()->EndOfEvent();
   Analysis::GetInstance()->EndOfEvent(anEvent);
 }
 
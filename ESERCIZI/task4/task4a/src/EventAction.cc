@@ -13,6 +13,7 @@
 #include "G4SDManager.hh"
 #include "G4DigiManager.hh"
 #include "G4Event.hh"
+#include "ProgressReporter.hh"
 #include "G4UnitsTable.hh"
 #include "Analysis.hh"
 
@@ -27,7 +28,6 @@ EventAction::EventAction()
 
 void EventAction::BeginOfEventAction(const G4Event* anEvent )
 {
-	G4cout<<"Starting Event: "<<anEvent->GetEventID()<<G4endl;
 	Analysis::GetInstance()->PrepareNewEvent(anEvent);
 	//Retrieve the ID for the hit collection
 	//if ( hitsCollID == -1 )
@@ -39,6 +39,7 @@ void EventAction::BeginOfEventAction(const G4Event* anEvent )
 
 void EventAction::EndOfEventAction(const G4Event* anEvent)
 {
+	ProgressReporter::GetInstance()->EndOfEvent();
 	Analysis::GetInstance()->EndOfEvent(anEvent);
 	//Digitize!!
 	//G4DigiManager * digiManager = G4DigiManager::GetDMpointer();
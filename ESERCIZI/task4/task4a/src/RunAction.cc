@@ -10,20 +10,30 @@
 
 #include "RunAction.hh"
 #include "G4Run.hh"
+#include "ProgressReporter.hh"
+#include "StepProfiler.hh"
 #include "G4RunManager.hh"
 #include "Analysis.hh"
 
 RunAction::RunAction()
 {
+	//Create the reporter and the profiler now so that their UI commands
+	//are available
+	ProgressReporter::GetInstance();
+	StepProfiler::GetInstance();
 }
 
 void RunAction::BeginOfRunAction(const G4Run* aRun )
 {
+	StepProfiler::GetInstance()->BeginOfRun();
+	ProgressReporter::GetInstance()->BeginOfRun(aRun->GetNumberOfEventToBeProcessed());
 	G4cout<<"Starting Run: "<<aRun->GetRunID()<<G4endl;
 	Analysis::GetInstance()->PrepareNewRun(aRun);
 }
 
 void RunAction::EndOfRunAction( const G4Run* aRun )
 {
+	StepProfiler::GetInstance()->EndOfRun();
+	ProgressReporter::GetInstance()->EndOfRun();
 	Analysis::GetInstance()->EndOfRun(aRun);
 }
@@ -1,6 +1,8 @@
 #include "SteppingAction.hh"
 //#include "G4Track.hh"
 #include "G4Step.hh"
+#include "ProgressReporter.hh"
+#include "StepProfiler.hh"
 //#include "G4ParticleDefinition.hh"
 //#include "G4ParticleTypes.hh"
 //#include "G4StepPoint.hh"
@@ -20,6 +22,9 @@ SteppingAction::~SteppingAction()
 }
 
 void SteppingAction::UserSteppingAction( const G4Step * theStep ) {
+	ProgressReporter::GetInstance()->AddStep();
+	StepProfiler* profiler = StepProfiler::GetInstance();
+	if ( profiler->IsEnabled() ) profiler->AddStep(theStep);
 	//Check if this is the first step of this event,
 	//in this case print out info and prepare for next event
 	//Ask the stepping manager if this is the first step of this
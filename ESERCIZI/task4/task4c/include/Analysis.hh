@@ -15,6 +15,8 @@
 
 #define NUMLAYERS 80
 
+class LayerProfileWriter;
+
 /*!
  * \brief Analysis class
  * This class contains the code to collect information from
@@ -61,6 +63,10 @@ private:
 	G4double thisEventTotHad[NUMLAYERS];
 	//! Array of energy in each layer of HAD calo for this run
 	G4double thisRunTotHad[NUMLAYERS];
+	//! ID of the HAD calo hits collection, retrieved at first event
+	G4int hadCaloCollID;
+	//! Event by event output of the HAD calo layers (see /layers/ commands)
+	LayerProfileWriter* layerWriter;
 };
 
 #endif /* ANALYSIS_HH_ */
@@ -10,6 +10,7 @@
 #include "globals.hh"
 #include "G4VUserDetectorConstruction.hh"
 #include "G4ThreeVector.hh"
+#include <vector>
 
 class G4LogicalVolume;
 class G4VPhysicalVolume;
@@ -125,6 +126,9 @@ private:
   G4double hadCaloFeThickness;
   G4double hadCaloRadius;
   G4int    hadCaloNumLayers;
+  //! absorber (Fe) and active (LAr) thickness of each layer, from the front
+  std::vector<G4double> hadCaloFeLayers;
+  std::vector<G4double> hadCaloLArLayers;
   G4ThreeVector posHadCalo;
   //@}
 };
@@ -0,0 +1,65 @@
+// $Id:$
+#ifndef HadCaloLayerParameterisation_h
+#define HadCaloLayerParameterisation_h 1
+
+/**
+ * @file
+ * @brief Defines class HadCaloLayerParameterisation.
+ */
+
+#include "globals.hh"
+#include "G4VPVParameterisation.hh"
+#include <vector>
+
+class G4VPhysicalVolume;
+class G4Tubs;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/*!
+\brief Places the active layers of a sampling calorimeter stack.
+
+The stack is described by two lists of thicknesses, one entry per layer:
+each layer is made of an absorber (the material of the mother volume)
+followed by an active disk. Thicknesses can change from layer to layer.
+
+A single G4PVParameterised uses this class to place all the active
+layers: the copy number of the volume is the layer index (0 for the
+first layer). Only the layer positions are stored, so memory and
+initialization time do not depend on geometry objects per layer.
+
+\sa ComputeTransformation(), ComputeDimensions()
+ */
+class HadCaloLayerParameterisation : public G4VPVParameterisation
+{
+public:
+  //! Constructor: absorber and active thickness of each layer, radius of the layers
+  HadCaloLayerParameterisation( const std::vector<G4double>& absorberThickness,
+                                const std::vector<G4double>& activeThickness,
+                                G4double radius );
+  //! Destructor
+  virtual ~HadCaloLayerParameterisation();
+
+  //! Position of the active layer copyNo w.r.t. the center of the stack
+  void ComputeTransformation( const G4int copyNo, G4VPhysicalVolume* physVol ) const;
+  //! Thickness of the active layer copyNo
+  void ComputeDimensions( G4Tubs& layer, const G4int copyNo, const G4VPhysicalVolume* physVol ) const;
+
+  //! \name simple get functions
+  //@{
+  G4int    GetNumberOfLayers() const { return activeHalfZ.size(); }
+  //! Total length of the stack (absorbers and active layers)
+  G4double GetTotalThickness() const { return totalThickness; }
+  //! Maximum thickness of an active layer (used to build the layer solid)
+  G4double GetMaxActiveThickness() const;
+  //@}
+private:
+  std::vector<G4double> activeZ;      //!< center of each active layer
+  std::vector<G4double> activeHalfZ;  //!< half thickness of each active layer
+  G4double totalThickness;
+  G4double layerRadius;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
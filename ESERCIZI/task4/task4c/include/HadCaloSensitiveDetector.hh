@@ -10,6 +10,7 @@
 
 #include "G4VSensitiveDetector.hh"
 #include "HadCaloHit.hh"
+#include <vector>
 
 class G4Step;
 class G4TouchableHistory;
@@ -24,13 +25,17 @@ class G4HCofThisEvent;           // <<- means "H(it) C(ollections) of This Event
  *  * position
  * in <i>Hit Collections of This Event</i>
  *
+ * During the event the energy is accumulated in a flat array with one
+ * entry per layer, the hits are created at the end of the event only for
+ * the layers with some energy deposit.
+ *
  * /sa ProcessHits()
  */
 class HadCaloSensitiveDetector : public G4VSensitiveDetector
 {
 public:
-  /// Constructor
-  HadCaloSensitiveDetector(G4String SDname);
+  /// Constructor: numLayers is the number of active layers
+  HadCaloSensitiveDetector(G4String SDname, G4int numLayers);
   /// Destructor
   ~HadCaloSensitiveDetector();
 
@@ -45,10 +50,12 @@ public:
   /// (optional) method of base class G4VSensitiveDetector
   void EndOfEvent(G4HCofThisEvent* HCE);
   //@}
+  /// Add energy to a layer without a G4Step (used by the fast simulation)
+  void AddLayerEnergy(G4int layerIndex, G4double edep);
 private:
-  typedef std::map<G4int,HadCaloHit*> hitMap_t; //< Helper mapping layer number with hit
-  hitMap_t hitMap;
+  std::vector<G4double> layerEdep;              //< Energy deposit in each layer for this event
   HadCaloHitCollection* hitCollection;          //< Collection of calorimetric hits
+  G4int HCID;                                   //< Collection ID, cached at first event
 };
 
 #endif
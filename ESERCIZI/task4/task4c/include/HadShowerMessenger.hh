@@ -0,0 +1,49 @@
+/*
+ * @file HadShowerMessenger.hh
+ *
+ * \brief defines class HadShowerMessenger
+ */
+
+#ifndef HADSHOWERMESSENGER_HH_
+#define HADSHOWERMESSENGER_HH_
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class HadShowerProfile;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+/*!
+ * \brief This class provides the user interface to the hadronic shower
+ * parameterisation
+ *
+ * \sa SetNewValue()
+ */
+class HadShowerMessenger : public G4UImessenger
+{
+public:
+	//! Constructor
+	HadShowerMessenger(HadShowerProfile*);
+	//! Destructor
+	virtual ~HadShowerMessenger();
+	//! handle user commands
+	void SetNewValue(G4UIcommand*,G4String);
+private:
+	HadShowerProfile*			profile;
+
+	G4UIdirectory*				showerDir;
+	G4UIcmdWithAString*			loadCmd;
+	G4UIcmdWithAString*			saveCmd;
+	G4UIcmdWithABool*			recordCmd;
+	G4UIcmdWithADoubleAndUnit*	minEnergyCmd;
+	G4UIcmdWithAnInteger*		spotsCmd;
+	G4UIcmdWithoutParameter*	clearCmd;
+	G4UIcmdWithoutParameter*	listCmd;
+};
+
+#endif /* HADSHOWERMESSENGER_HH_ */
@@ -0,0 +1,53 @@
+/*
+ * @file HadShowerModel.hh
+ *
+ * \brief defines class HadShowerModel
+ */
+
+#ifndef HADSHOWERMODEL_HH_
+#define HADSHOWERMODEL_HH_
+
+#include "globals.hh"
+#include "G4VFastSimulationModel.hh"
+
+class G4Region;
+class HadCaloSensitiveDetector;
+
+/*!
+ * \brief Fast simulation of hadronic showers in the HAD calo.
+ *
+ * Hadrons entering the HAD calo region with a kinetic energy above a
+ * threshold are killed and their shower is replaced by energy spots
+ * deposited directly in the layers of the sensitive detector:
+ *  - the visible energy fraction and the depth of the shower barycenter
+ *    are sampled from a correlated gaussian pair: a large electromagnetic
+ *    fraction gives a short shower with more visible energy
+ *  - the depth of each spot along the direction of the hadron is sampled
+ *    from a gamma distribution with this mean and the tabulated width
+ * The model is active only when shower parameters are available and they
+ * are not being fitted (\sa HadShowerProfile), so without
+ * /hadshower/load the full simulation is used.
+ */
+class HadShowerModel : public G4VFastSimulationModel
+{
+public:
+	//! Constructor: the model is attached to the region of the HAD calo
+	HadShowerModel(const G4String& name, G4Region* envelope, HadCaloSensitiveDetector* sd);
+	//! Destructor
+	virtual ~HadShowerModel();
+
+	//! \name methods from base class G4VFastSimulationModel
+	//@{
+	//! Only hadrons (baryons and mesons)
+	G4bool IsApplicable(const G4ParticleDefinition& particle);
+	//! Energy above threshold and parameters available.
+	//! While the parameters are fitted the hadron is recorded instead
+	G4bool ModelTrigger(const G4FastTrack& fastTrack);
+	//! Deposit the shower and kill the hadron
+	void DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep);
+	//@}
+private:
+	HadCaloSensitiveDetector* sensitive;
+};
+
+#endif /* HADSHOWERMODEL_HH_ */
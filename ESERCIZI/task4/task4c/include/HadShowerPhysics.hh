@@ -0,0 +1,34 @@
+/*
+ * @file HadShowerPhysics.hh
+ *
+ * \brief defines class HadShowerPhysics
+ */
+
+#ifndef HADSHOWERPHYSICS_HH_
+#define HADSHOWERPHYSICS_HH_
+
+#include "globals.hh"
+#include "G4VPhysicsConstructor.hh"
+
+/*!
+ * \brief Adds the fast simulation process to hadrons.
+ *
+ * The G4FastSimulationManagerProcess gives the fast simulation models
+ * (\sa HadShowerModel) the possibility to take over the tracking.
+ * Register it with the reference physics list:
+ * physicsList->RegisterPhysics( new HadShowerPhysics() )
+ */
+class HadShowerPhysics : public G4VPhysicsConstructor
+{
+public:
+	//! Constructor
+	HadShowerPhysics(const G4String& name = "HadShowerFastSim");
+	//! Destructor
+	virtual ~HadShowerPhysics();
+	//! Particles are defined by the other constructors
+	void ConstructParticle() {}
+	//! Add the fast simulation process to baryons and mesons
+	void ConstructProcess();
+};
+
+#endif /* HADSHOWERPHYSICS_HH_ */
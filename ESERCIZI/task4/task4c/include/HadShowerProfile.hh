@@ -0,0 +1,135 @@
+/*
+ * @file HadShowerProfile.hh
+ *
+ * \brief HadShowerProfile class
+ */
+
+#ifndef HADSHOWERPROFILE_HH_
+#define HADSHOWERPROFILE_HH_
+
+#include "globals.hh"
+#include <vector>
+
+class HadShowerMessenger;
+
+/*!
+ * \brief Parameters of the hadronic shower parameterisation of the HAD calo.
+ *
+ * For a set of incident energies (kinetic energy of the hadron when it
+ * enters the HAD calo) the table stores:
+ *  - the visible energy (energy in LAr) as a fraction of the incident energy:
+ *    mean and sigma
+ *  - the depth of the shower barycenter from the point where the hadron
+ *    enters the calo: mean and sigma
+ *  - the correlation between the two: showers with a large electromagnetic
+ *    fraction are shorter and give more visible energy (e/h > 1)
+ *  - the mean longitudinal width of the shower relative to its barycenter depth
+ * Between two energies the parameters are interpolated linearly in log(E).
+ *
+ * The same class is the tool to derive the parameters: when recording is
+ * switched on, the model records the most energetic hadron entering the
+ * calo (RecordEntry()), the energy in each layer of full-simulation events
+ * is added with AddEvent() and at the end of the run the moments of the
+ * distributions give a new entry of the table (one run per energy).
+ * The table can be saved to / loaded from a text file, see HadShowerMessenger.
+ *
+ * The class is designed as a singleton.
+ * \sa HadShowerModel
+ */
+class HadShowerProfile {
+public:
+	//! Singleton pattern
+	static HadShowerProfile* GetInstance() {
+		if ( HadShowerProfile::singleton == NULL ) HadShowerProfile::singleton = new HadShowerProfile();
+		return HadShowerProfile::singleton;
+	}
+	//! destructor
+	virtual ~HadShowerProfile();
+
+	//! Parameters for a given incident energy
+	struct Parameters {
+		G4double energy;		//!< incident kinetic energy
+		G4double visMean;		//!< mean visible energy fraction
+		G4double visSigma;		//!< sigma of visible energy fraction
+		G4double depthMean;		//!< mean shower barycenter depth from the entry point
+		G4double depthSigma;	//!< sigma of the barycenter depth
+		G4double correlation;	//!< correlation of visible fraction and depth
+		G4double width;			//!< mean longitudinal rms / barycenter depth
+	};
+
+	//! Describe the layers: absorber and active thickness of each layer, from the front
+	void SetLayers( const std::vector<G4double>& absorberThickness,
+					const std::vector<G4double>& activeThickness );
+	//! Layer (absorber+active) containing this depth from the calo front, -1 if outside
+	G4int FindLayer( G4double depth ) const;
+	G4int GetNumberOfLayers() const { return layerBack.size(); }
+	G4double GetTotalThickness() const { return layerBack.empty() ? 0 : layerBack.back(); }
+
+	//! True if the table can be used by the fast simulation
+	G4bool HasParameters() const { return !table.empty(); }
+	//! Parameters for this energy, interpolated from the table
+	Parameters Interpolate( G4double energy ) const;
+
+	//! \name fit of the parameters from full simulation
+	//@{
+	void SetRecording( G4bool val ) { recording = val; }
+	G4bool IsRecording() const { return recording; }
+	//! Reset the accumulated moments
+	void PrepareNewRun();
+	//! Forget the hadron recorded in the previous event
+	void PrepareNewEvent() { entryEnergy = 0; entryDepth = 0; }
+	//! Hadron entering the calo, at this depth from the front: the most
+	//! energetic one of the event is kept (a track loses energy along its path)
+	void RecordEntry( G4double energy, G4double depth );
+	//! Add an event: visible energy in each layer, for the hadron recorded
+	void AddEvent( const G4double* layerEdep, G4int numLayers );
+	//! Compute the parameters for this run and add them to the table
+	void EndOfRun();
+	//@}
+
+	//! \name set functions and table handling used by the messenger
+	//@{
+	void SetMinEnergy( G4double val ) { minEnergy = val; }
+	G4double GetMinEnergy() const { return minEnergy; }
+	void SetNumberOfSpots( G4int val ) { numSpots = val; }
+	G4int GetNumberOfSpots() const { return numSpots; }
+	G4bool Load( const G4String& fileName );
+	G4bool Save( const G4String& fileName ) const;
+	void Clear() { table.clear(); }
+	void List() const;
+	//@}
+private:
+	//! Private construtor: part of singleton pattern
+	HadShowerProfile();
+	//! Singleton static instance
+	static HadShowerProfile* singleton;
+	HadShowerMessenger* messenger;
+	//! Insert in the table keeping it sorted by energy, replaces an existing energy
+	void Insert( const Parameters& par );
+
+	//! Parameters, sorted by energy
+	std::vector<Parameters> table;
+	//! Back face of each layer, depth from the calo front
+	std::vector<G4double> layerBack;
+	//! Center of each active layer, depth from the calo front
+	std::vector<G4double> activeCenter;
+	//! Fast simulation is used only above this kinetic energy
+	G4double minEnergy;
+	//! Number of energy spots deposited per shower
+	G4int numSpots;
+
+	//! \name moments accumulated while recording
+	//@{
+	G4bool recording;
+	G4double entryEnergy;
+	G4double entryDepth;
+	G4int numEvents;
+	G4double sumEnergy;
+	G4double sumVis, sumVis2;
+	G4double sumDepth, sumDepth2;
+	G4double sumVisDepth;
+	G4double sumWidth;
+	//@}
+};
+
+#endif /* HADSHOWERPROFILE_HH_ */
@@ -0,0 +1,73 @@
+/*
+ * @file LayerProfileWriter.hh
+ *
+ * \brief defines class LayerProfileWriter
+ */
+
+#ifndef LAYERPROFILEWRITER_HH_
+#define LAYERPROFILEWRITER_HH_
+
+#include "globals.hh"
+#include <fstream>
+#include <vector>
+
+class LayerProfileWriterMessenger;
+
+/*!
+ * \brief Writes the energy of each HAD calo layer, event by event, in a compact file.
+ *
+ * Energies are stored as integer multiples of a quantum (/layers/quantum,
+ * default 10 keV): decoding gives back each energy within half a quantum.
+ * Each run is written to a file <prefix>_run<N>.dat (/layers/file <prefix>,
+ * nothing is written if no prefix is given) made of:
+ *  - a header: "L16P", version (uint16), number of layers (uint16),
+ *    quantum in MeV (double)
+ *  - for each event: event ID (uint32), number of codes (uint16), codes (uint16)
+ * Codes are read layer after layer, from the first one:
+ *  - 0x0000-0x7FFF: energy of the layer in quanta
+ *  - 0x8000|n: n layers with no energy
+ *  - 0xFFFF: energy too large for 15 bits, a uint32 with the quanta follows
+ *    (stored as two codes, low word first)
+ * Layers after the last one with energy are not written.
+ * Numbers are in the byte order of the machine that wrote the file.
+ * readLayers.py decodes the file.
+ */
+class LayerProfileWriter
+{
+public:
+	//! Constructor
+	LayerProfileWriter();
+	//! Destructor
+	virtual ~LayerProfileWriter();
+	//! Open the file of this run, if a prefix is set
+	void Open( G4int runID, G4int numLayers );
+	//! Encode and write the layers energy of an event
+	void AddEvent( G4int eventID, const G4double* layerEdep, G4int numLayers );
+	//! Close the file and print the compression
+	void Close();
+	//! True if a file is open
+	G4bool IsOpen() const { return out.is_open(); }
+
+	//! \name set functions used by the messenger
+	//@{
+	void SetFilePrefix( const G4String& prefix ) { filePrefix = prefix; }
+	void SetQuantum( G4double val ) { quantum = val; }
+	//@}
+private:
+	LayerProfileWriterMessenger* messenger;
+	G4String filePrefix;
+	//! Energy of one unit of the stored integers
+	G4double quantum;
+	std::ofstream out;
+	//! Codes of the current event, reused
+	std::vector<unsigned short> codes;
+	//! \name statistics of the current file
+	//@{
+	G4int numLayersInFile;
+	G4int eventsWritten;
+	G4double bytesWritten;
+	G4int overflows;
+	//@}
+};
+
+#endif /* LAYERPROFILEWRITER_HH_ */
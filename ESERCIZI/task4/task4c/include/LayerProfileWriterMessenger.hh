@@ -0,0 +1,40 @@
+/*
+ * @file LayerProfileWriterMessenger.hh
+ *
+ * \brief defines class LayerProfileWriterMessenger
+ */
+
+#ifndef LAYERPROFILEWRITERMESSENGER_HH_
+#define LAYERPROFILEWRITERMESSENGER_HH_
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class LayerProfileWriter;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+
+/*!
+ * \brief This class provides the user interface to LayerProfileWriter
+ *
+ * \sa SetNewValue()
+ */
+class LayerProfileWriterMessenger : public G4UImessenger
+{
+public:
+	//! Constructor
+	LayerProfileWriterMessenger(LayerProfileWriter*);
+	//! Destructor
+	virtual ~LayerProfileWriterMessenger();
+	//! handle user commands
+	void SetNewValue(G4UIcommand*,G4String);
+private:
+	LayerProfileWriter*			writer;
+
+	G4UIdirectory*				layersDir;
+	G4UIcmdWithAString*			fileCmd;
+	G4UIcmdWithADoubleAndUnit*	quantumCmd;
+};
+
+#endif /* LAYERPROFILEWRITERMESSENGER_HH_ */
@@ -0,0 +1,100 @@
+/*
+ * @file TrackKiller.hh
+ *
+ * \brief TrackKiller class
+ */
+
+#ifndef TRACKKILLER_HH_
+#define TRACKKILLER_HH_
+
+#include "globals.hh"
+#include <map>
+#include <vector>
+
+class G4Track;
+class G4Step;
+class G4Region;
+class TrackKillerMessenger;
+
+/*!
+ * \brief Kills slow neutrons and late tracks, region by region.
+ *
+ * For each region two cuts can be set from UI (\sa TrackKillerMessenger):
+ *  - neutrons with kinetic energy below a threshold are killed
+ *  - any track with global time above a limit is killed
+ * Tracks are killed when created (\sa StackingAction) or while
+ * stepping (\sa SteppingAction). The number of killed tracks and their
+ * kinetic energy are summed region by region and printed at the end of
+ * the run, to estimate the bias introduced by the cuts of each region.
+ * The class is designed as a singleton.
+ */
+class TrackKiller {
+public:
+	//! Singleton pattern
+	static TrackKiller* GetInstance() {
+		if ( TrackKiller::singleton == NULL ) TrackKiller::singleton = new TrackKiller();
+		return TrackKiller::singleton;
+	}
+	//! destructor
+	virtual ~TrackKiller();
+	//! Resolve the regions and reset the counters
+	void PrepareNewRun();
+	//! Print the summary of killed tracks
+	void EndOfRun(G4int numEvents);
+	//! True if a new track has to be killed (called by StackingAction)
+	G4bool KillNewTrack( const G4Track* aTrack );
+	//! Kill the track of this step if needed (called by SteppingAction)
+	void CheckStep( const G4Step* aStep );
+	//! No cut defined: stepping and stacking can skip the checks
+	G4bool IsActive() const { return !cuts.empty(); }
+
+	//! \name set functions used by the messenger
+	//@{
+	void SelectRegion( const G4String& name ) { currentRegion = name; }
+	void SetNeutronEnergyCut( G4double val ) { cuts[currentRegion].neutronEnergy = val; }
+	void SetTimeCut( G4double val ) { cuts[currentRegion].time = val; }
+	void ListCuts() const;
+	//@}
+private:
+	//! Private construtor: part of singleton pattern
+	TrackKiller();
+	//! Singleton static instance
+	static TrackKiller* singleton;
+	TrackKillerMessenger* messenger;
+
+	//! cuts of one region
+	struct Cuts {
+		Cuts() : neutronEnergy(0), time(DBL_MAX) {}
+		G4double neutronEnergy;
+		G4double time;
+	};
+	//! cuts of a region resolved for the run, with the killed tracks
+	struct RegionCuts {
+		RegionCuts( const G4Region* reg , const Cuts& c ) :
+			region(reg), cuts(c),
+			numKilledNeutrons(0), energyKilledNeutrons(0),
+			numKilledLate(0), energyKilledLate(0) {}
+		const G4Region* region;
+		Cuts cuts;
+		//! \name counters for this run
+		//@{
+		G4int    numKilledNeutrons;
+		G4double energyKilledNeutrons;
+		G4int    numKilledLate;
+		G4double energyKilledLate;
+		//@}
+	};
+	//! Return the cuts of the region of the track, 0 if none
+	RegionCuts* FindCuts( const G4Track* aTrack );
+	//! Add up a killed track
+	void Kill( RegionCuts* regCuts , const G4Track* aTrack , G4bool byTime );
+
+	//! cuts as given from UI, by region name
+	std::map<G4String,Cuts> cuts;
+	//! region selected from UI
+	G4String currentRegion;
+	//! cuts resolved at the beginning of the run
+	std::vector<RegionCuts> regionCuts;
+};
+
+#endif /* TRACKKILLER_HH_ */
@@ -0,0 +1,43 @@
+/*
+ * @file TrackKillerMessenger.hh
+ *
+ * \brief defines class TrackKillerMessenger
+ */
+
+#ifndef TRACKKILLERMESSENGER_HH_
+#define TRACKKILLERMESSENGER_HH_
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class TrackKiller;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+/*!
+ * \brief This class provides the user interface to TrackKiller
+ *
+ * \sa SetNewValue()
+ */
+class TrackKillerMessenger : public G4UImessenger
+{
+public:
+	//! Constructor
+	TrackKillerMessenger(TrackKiller*);
+	//! Destructor
+	virtual ~TrackKillerMessenger();
+	//! handle user commands
+	void SetNewValue(G4UIcommand*,G4String);
+private:
+	TrackKiller*				killer;
+
+	G4UIdirectory*				killerDir;
+	G4UIcmdWithAString*			regionCmd;
+	G4UIcmdWithADoubleAndUnit*	neutronEnergyCmd;
+	G4UIcmdWithADoubleAndUnit*	timeCmd;
+	G4UIcmdWithoutParameter*	listCmd;
+};
+
+#endif /* TRACKKILLERMESSENGER_HH_ */
@@ -0,0 +1,54 @@
+#!/usr/bin/python
+##@file readLayers.py
+# Decode the HAD calo layers files written with /layers/file.
+#
+# Usage: readLayers.py layers_run0.dat
+# Prints the average energy per layer; use events() to loop on the
+# event by event profiles (energies in MeV, within half a quantum).
+
+import struct
+import sys
+
+def events(fileName):
+    """Yield (eventID, [energy of each layer in MeV]) for each event of the file"""
+    f = open(fileName, 'rb')
+    if f.read(4) != b'L16P':
+        raise IOError(fileName + ' is not a layers file')
+    version, numLayers, quantum = struct.unpack('=HHd', f.read(12))
+    while True:
+        head = f.read(6)
+        if len(head) < 6:
+            break
+        eventID, numCodes = struct.unpack('=IH', head)
+        codes = struct.unpack('=%dH' % numCodes, f.read(2 * numCodes))
+        energies = [0.] * numLayers
+        layer = 0
+        i = 0
+        while i < numCodes:
+            code = codes[i]
+            if code == 0xFFFF:
+                energies[layer] = (codes[i + 1] | (codes[i + 2] << 16)) * quantum
+                layer += 1
+                i += 3
+                continue
+            if code & 0x8000:
+                layer += code & 0x7FFF
+            else:
+                energies[layer] = code * quantum
+                layer += 1
+            i += 1
+        yield eventID, energies
+    f.close()
+
+if __name__ == '__main__':
+    total = None
+    numEvents = 0
+    for eventID, energies in events(sys.argv[1]):
+        if total is None:
+            total = [0.] * len(energies)
+        total = [t + e for t, e in zip(total, energies)]
+        numEvents += 1
+    print('Events: %d' % numEvents)
+    if numEvents > 0:
+        for layer, e in enumerate(total):
+            print('Layer %d: %g MeV' % (layer, e / numEvents))
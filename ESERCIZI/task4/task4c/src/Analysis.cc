@@ -9,6 +9,8 @@
 #include "G4UnitsTable.hh"
 #include "G4SDManager.hh"
 #include "HadCaloHit.hh"
+#include "HadShowerProfile.hh"
+#include "LayerProfileWriter.hh"
 
 
 Analysis* Analysis::singleton = 0;
@@ -17,8 +19,10 @@ Analysis::Analysis() :
 	thisEventTotEM(0),
 	thisEventSecondaries(0),
 	thisRunTotEM(0),
-	thisRunTotSecondaries(0)
+	thisRunTotSecondaries(0),
+	hadCaloCollID(-1)
 {
+	layerWriter = new LayerProfileWriter();
 }
 
 void Analysis::PrepareNewEvent(const G4Event* /*anEvent*/)
@@ -27,10 +31,13 @@ void Analysis::PrepareNewEvent(const G4Event* /*anEvent*/)
 	thisEventSecondaries = 0;
 	thisEventTotEM = 0;
 	for ( int i = 0; i<NUMLAYERS ; ++i ) thisEventTotHad[i]=0;
+	HadShowerProfile::GetInstance()->PrepareNewEvent();
 }
 
-void Analysis::PrepareNewRun(const G4Run* /*aRun*/ )
+void Analysis::PrepareNewRun(const G4Run* aRun )
 {
+	//Open the layers output for this run, if requested
+	layerWriter->Open(aRun->GetRunID(),NUMLAYERS);
 	//Reset variables relative to the run
 	thisRunTotEM = 0;
 	thisRunTotSecondaries = 0;
@@ -44,14 +51,18 @@ void Analysis::EndOfEvent(const G4Event* anEvent)
 	thisRunTotSecondaries += thisEventSecondaries;
 	//We want now to retrieve the collection of hits created by the HadCalo SD
 	//We need to know the collection ID associated with the collection name,
-	//for this purpose we can ask the Sensiteive
-	G4SDManager* SDman = G4SDManager::GetSDMpointer();
-	G4int hitCollID = SDman->GetCollectionID("HadCaloHitCollection");
+	//for this purpose we can ask the Sensiteive. The ID does not change
+	//during the job, we look it up only once
+	if ( hadCaloCollID < 0 )
+	{
+		G4SDManager* SDman = G4SDManager::GetSDMpointer();
+		hadCaloCollID = SDman->GetCollectionID("HadCaloHitCollection");
+	}
 	G4HCofThisEvent* hitsCollections = anEvent->GetHCofThisEvent();
 	HadCaloHitCollection* hits = 0;
-	if ( hitsCollections )
+	if ( hitsCollections && hadCaloCollID >= 0 )
 	{
-		hits = static_cast<HadCaloHitCollection*>(hitsCollections->GetHC(hitCollID));
+		hits = static_cast<HadCaloHitCollection*>(hitsCollections->GetHC(hadCaloCollID));
 	}
 	if ( hits ) //hits container found we can proceed
 	{
@@ -73,10 +84,19 @@ void Analysis::EndOfEvent(const G4Event* anEvent)
 		}
 	}
 	for ( int i = 0; i<NUMLAYERS ; ++i ) thisRunTotHad[i] += thisEventTotHad[i];
+	if ( layerWriter->IsOpen() ) layerWriter->AddEvent(anEvent->GetEventID(),thisEventTotHad,NUMLAYERS);
+	//Full simulation events are used to fit the shower parameterisation,
+	//against the hadron entering the HAD calo (the EM calo is upstream)
+	HadShowerProfile* showerProfile = HadShowerProfile::GetInstance();
+	if ( showerProfile->IsRecording() )
+	{
+		showerProfile->AddEvent(thisEventTotHad,NUMLAYERS);
+	}
 }
 
 void Analysis::EndOfRun(const G4Run* aRun)
 {
+	layerWriter->Close();
 	//Some print outs
 	G4int numEvents = aRun->GetNumberOfEvent();
 
@@ -13,6 +13,8 @@
 #include "G4LogicalVolume.hh"
 #include "G4PVPlacement.hh"
 #include "G4PVReplica.hh"
+#include "G4PVParameterised.hh"
+#include "G4Region.hh"
 
 #include "G4GeometryTolerance.hh"
 #include "G4GeometryManager.hh"
@@ -22,6 +24,9 @@
 #include "G4Colour.hh"
 
 #include "HadCaloSensitiveDetector.hh"
+#include "HadCaloLayerParameterisation.hh"
+#include "HadShowerModel.hh"
+#include "HadShowerProfile.hh"
 #include "G4SDManager.hh"
 
 DetectorConstruction::DetectorConstruction()
@@ -91,7 +96,13 @@ void DetectorConstruction::ComputeParameters()
 	hadCaloFeThickness = 20*mm;
 	hadCaloRadius = 800*mm;
 	hadCaloNumLayers = 80;
-	posHadCalo = G4ThreeVector(0,0,(hadCaloLArThickness+hadCaloFeThickness)*hadCaloNumLayers/2);
+	//The stack is described layer by layer, thicknesses may be different for each layer
+	hadCaloFeLayers.assign(hadCaloNumLayers,hadCaloFeThickness);
+	hadCaloLArLayers.assign(hadCaloNumLayers,hadCaloLArThickness);
+	G4double hadCaloLength = 0;
+	for ( int layerIdx = 0 ; layerIdx < hadCaloNumLayers ; ++layerIdx )
+		hadCaloLength += hadCaloFeLayers[layerIdx] + hadCaloLArLayers[layerIdx];
+	posHadCalo = G4ThreeVector(0,0,hadCaloLength/2);
 }
  
 G4VPhysicalVolume* DetectorConstruction::Construct()
@@ -265,7 +276,11 @@ G4VPhysicalVolume* DetectorConstruction::ConstructEMCalo()
 
 G4VPhysicalVolume* DetectorConstruction::ConstructHadCalo()
 {
-	G4double halfHadCaloHalfZ = (hadCaloFeThickness+hadCaloLArThickness)*hadCaloNumLayers/2;
+	//The layers (Fe absorber followed by LAr) are placed by a parameterisation:
+	//it knows the position and thickness of each layer
+	HadCaloLayerParameterisation* layerParam =
+		new HadCaloLayerParameterisation(hadCaloFeLayers,hadCaloLArLayers,hadCaloRadius);
+	G4double halfHadCaloHalfZ = layerParam->GetTotalThickness()/2;
 	G4Tubs* hadCaloSolid = new G4Tubs( "hadCaloSolid",//its name
 										0, //inner radius
 										hadCaloRadius,//outer radius
@@ -275,11 +290,17 @@ G4VPhysicalVolume* DetectorConstruction::ConstructHadCalo()
 	G4LogicalVolume* hadCaloLogic = new G4LogicalVolume( hadCaloSolid,//its solid
 														 fe,//its material
 														 "HadCaloLogic");//its name
+	//The HAD calo is a region: cuts and track killing can be set only here
+	G4Region* hadCaloRegion = new G4Region("HadCalo");
+	hadCaloLogic->SetRegion(hadCaloRegion);
+	hadCaloRegion->AddRootLogicalVolume(hadCaloLogic);
 	//We now make layers of LAr and add them to the hadronic calo logic
-	G4Tubs* hadLayerSolid = new G4Tubs( "HadCaloLayerSolid", 0 , hadCaloRadius , hadCaloLArThickness/2, 0, CLHEP::twopi);
+	//The thickness is modified for each layer by the parameterisation
+	G4Tubs* hadLayerSolid = new G4Tubs( "HadCaloLayerSolid", 0 , hadCaloRadius ,
+										layerParam->GetMaxActiveThickness()/2, 0, CLHEP::twopi);
 
 	//We need to create a SD and attach it to the active layer of the HAD calorimeter: The LAr logic volume
-	HadCaloSensitiveDetector* sensitive = new HadCaloSensitiveDetector("/HadClo");
+	HadCaloSensitiveDetector* sensitive = new HadCaloSensitiveDetector("/HadClo",layerParam->GetNumberOfLayers());
 	//We need to register the sensitive detector with the manager
 	G4SDManager::GetSDMpointer()->AddNewDetector(sensitive);
 
@@ -292,17 +313,20 @@ G4VPhysicalVolume* DetectorConstruction::ConstructHadCalo()
 	//                   G4UserLimits* pULimits=0,
 	//                   G4bool optimise=true);
 	G4LogicalVolume* hadLayerLogic = new G4LogicalVolume(hadLayerSolid,lar,"HadLayerLogic",0,sensitive);
-	//Translation of one Layer with respect previous Layer
-	G4ThreeVector absorberLayer(0,0,hadCaloFeThickness);
-	G4ThreeVector activeLayer(0,0,hadCaloLArThickness);
+	//Hadronic showers can be parameterised in the region, the model deposits
+	//the energy directly in the layers of the SD (see /hadshower/ commands)
+	HadShowerProfile::GetInstance()->SetLayers(hadCaloFeLayers,hadCaloLArLayers);
+	new HadShowerModel("HadShowerModel",hadCaloRegion,sensitive);
+	//A single parameterised volume for all layers: the copy number is the layer
+	//index (0 to hadCaloNumLayers-1). Layers are stacked along z, kZAxis lets the
+	//navigator voxelise along this axis only
+	new G4PVParameterised("HadCaloLayer",		//its name
+						  hadLayerLogic,		//its logical volume
+						  hadCaloLogic,			//its mother
+						  kZAxis,				//axis of the stack
+						  layerParam->GetNumberOfLayers(),//number of layers
+						  layerParam);			//the parameterisation
 	G4int hadCaloCopyNum = 1000;
-	G4int layerCopyNum = hadCaloCopyNum;
-	for ( int layerIdx = 0 ; layerIdx < hadCaloNumLayers ; ++layerIdx )
-	{
-		G4ThreeVector position = (layerIdx+1)*absorberLayer + (layerIdx+0.5)*activeLayer;
-		position -= G4ThreeVector(0,0,halfHadCaloHalfZ);//Position is w.r.t. center of mother volume: the hadCaloLogic
-		new G4PVPlacement(0,position,hadLayerLogic,"HadCaloLayer",hadCaloLogic,false,++layerCopyNum);
-	}
 	hadCalo = new G4PVPlacement( 0, //no rotation
 							     posHadCalo, //translation
 							     hadCaloLogic,//its logical volume
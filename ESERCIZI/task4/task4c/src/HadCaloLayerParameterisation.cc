@@ -0,0 +1,65 @@
+// $Id:$
+/**
+ * @file
+ * @brief Implements class HadCaloLayerParameterisation.
+ */
+
+#include "HadCaloLayerParameterisation.hh"
+
+#include "G4VPhysicalVolume.hh"
+#include "G4ThreeVector.hh"
+#include "G4Tubs.hh"
+
+#include <algorithm>
+
+HadCaloLayerParameterisation::HadCaloLayerParameterisation(
+		const std::vector<G4double>& absorberThickness,
+		const std::vector<G4double>& activeThickness,
+		G4double radius ) :
+	totalThickness(0),
+	layerRadius(radius)
+{
+	size_t numLayers = std::min( absorberThickness.size() , activeThickness.size() );
+	activeZ.reserve(numLayers);
+	activeHalfZ.reserve(numLayers);
+	//Positions are first computed from the front face of the stack...
+	for ( size_t layerIdx = 0 ; layerIdx < numLayers ; ++layerIdx )
+	{
+		totalThickness += absorberThickness[layerIdx];
+		activeHalfZ.push_back( activeThickness[layerIdx]/2 );
+		activeZ.push_back( totalThickness + activeHalfZ.back() );
+		totalThickness += activeThickness[layerIdx];
+	}
+	//...and then w.r.t. the center of the mother volume
+	for ( size_t layerIdx = 0 ; layerIdx < numLayers ; ++layerIdx )
+		activeZ[layerIdx] -= totalThickness/2;
+}
+
+HadCaloLayerParameterisation::~HadCaloLayerParameterisation()
+{
+}
+
+G4double HadCaloLayerParameterisation::GetMaxActiveThickness() const
+{
+	G4double maxHalfZ = 0;
+	for ( size_t layerIdx = 0 ; layerIdx < activeHalfZ.size() ; ++layerIdx )
+		maxHalfZ = std::max( maxHalfZ , activeHalfZ[layerIdx] );
+	return 2*maxHalfZ;
+}
+
+void HadCaloLayerParameterisation::ComputeTransformation( const G4int copyNo,
+		G4VPhysicalVolume* physVol ) const
+{
+	physVol->SetTranslation( G4ThreeVector(0,0,activeZ[copyNo]) );
+	physVol->SetRotation(0);
+}
+
+void HadCaloLayerParameterisation::ComputeDimensions( G4Tubs& layer, const G4int copyNo,
+		const G4VPhysicalVolume* ) const
+{
+	layer.SetInnerRadius(0);
+	layer.SetOuterRadius(layerRadius);
+	layer.SetZHalfLength(activeHalfZ[copyNo]);
+	layer.SetStartPhiAngle(0);
+	layer.SetDeltaPhiAngle(CLHEP::twopi);
+}
@@ -15,8 +15,13 @@
 #include "G4UnitsTable.hh"
 #include "Analysis.hh"
 
-HadCaloSensitiveDetector::HadCaloSensitiveDetector(G4String SDname)
-  : G4VSensitiveDetector(SDname)
+#include <cstring>
+
+HadCaloSensitiveDetector::HadCaloSensitiveDetector(G4String SDname, G4int numLayers)
+  : G4VSensitiveDetector(SDname),
+    layerEdep(numLayers,0.),
+    hitCollection(0),
+    HCID(-1)
 {
 	G4cout<<"Creating SD with name: "<<SDname<<G4endl;
   // 'collectionName' is a protected data member of base class G4VSensitiveDetector.
@@ -27,7 +32,7 @@ HadCaloSensitiveDetector::HadCaloSensitiveDetector(G4String SDname)
 	//---------------
 	// Add myCollectionName to the vector of names called collectionName variable
 	// Hint1: use insert method:
-	//collectionName.insert();
+	collectionName.insert(myCollectionName);
  
   // Note that we may add as many collection names we would wish: ie
   // a sensitive detector can have many collections.
@@ -44,9 +49,9 @@ G4bool HadCaloSensitiveDetector::ProcessHits(G4Step *step, G4TouchableHistory *)
 	//To identify where the step is we use the touchable navigation,
 	//remember we need to use PreStepPoint!
 	G4TouchableHandle touchable = step->GetPreStepPoint()->GetTouchableHandle();
-	G4int copyNo = touchable->GetVolume(0)->GetCopyNo();
-	//Hadronic layers have number from 1001 to 1080. The index is from 0 to 79:
-	G4int layerIndex = copyNo-1001;
+	//Hadronic layers are a parameterised volume: the replica number
+	//is directly the layer index, from 0 to 79
+	G4int layerIndex = touchable->GetReplicaNumber(0);
 	//We get now the energy deposited by this step
 	G4double edep = step->GetTotalEnergyDeposit();
 
@@ -68,32 +73,24 @@ G4bool HadCaloSensitiveDetector::ProcessHits(G4Step *step, G4TouchableHistory *)
 
 	//Hits in caloriemters are tricky, to avoid to create too many hits we make them
 	//accumulate energy on each plane.
-	//Thus we need to know if the hit for a specific layer has already been created or not.
-	//We use the mapHit map to verify this.
-	//We could have done searching the hit in the hitCollection,
-	//but a std::map is more efficient in searching.
-	//Since this is called several times for each event, this is a place of the code
-	//to be optimized
-	hitMap_t::iterator it = hitMap.find(layerIndex);
-	HadCaloHit* aHit = 0;
-	if ( it != hitMap.end() )
-	{
-		//Hit for this layer already exists
-		//remember the hit pointer
-		aHit = it->second;
-	}
-	else
+	//Energy is summed in a plain array indexed by layer, this is called several
+	//times for each event so we avoid any search here: the hits are created
+	//once per layer in EndOfEvent
+	if ( layerIndex < 0 || layerIndex >= static_cast<G4int>(layerEdep.size()) )
 	{
-		//Hit for this layer does not exists,
-		//we create it
-		aHit = new HadCaloHit(layerIndex);
-		hitMap.insert( std::make_pair(layerIndex,aHit) );
-		hitCollection->insert(aHit);
+		G4cerr<<"HadCaloSensitiveDetector: unexpected layer "<<layerIndex<<G4endl;
+		return false;
 	}
-	aHit->AddEdep( edep );
+	layerEdep[layerIndex] += edep;
 	return true;
 }
 
+void HadCaloSensitiveDetector::AddLayerEnergy(G4int layerIndex, G4double edep)
+{
+	if ( layerIndex < 0 || layerIndex >= static_cast<G4int>(layerEdep.size()) ) return;
+	layerEdep[layerIndex] += edep;
+}
+
 void HadCaloSensitiveDetector::Initialize(G4HCofThisEvent* HCE)
 {
 	// -- Creation of the collection
@@ -107,22 +104,32 @@ void HadCaloSensitiveDetector::Initialize(G4HCofThisEvent* HCE)
 	// hitCollection = new HadCaloHitCollection( EdITME:SD_name, EDITME:collection_name )
 	// Hint 1: Get the SD_name with the GetName() function,
 	// Hint 2: Get the collection_name from the collectionName vector: your collection is at position 0: collectionName[0]
+	hitCollection = new HadCaloHitCollection( GetName(), collectionName[0] );
 
 
 	// -- and attachment of this collection to the "Hits Collection of this Event":
 	// -- To insert the collection, we need to get an index for it. This index
 	// -- is unique to the collection. It is provided by the GetCollectionID(...)
 	// -- method (which calls what is needed in the kernel to get this index).
-	static G4int HCID = -1;
 	if (HCID<0) HCID = GetCollectionID(0); // <<-- this is to get an ID for collectionName[0]
 	HCE->AddHitsCollection(HCID, hitCollection);
 
-	//Reset map of hits
-	hitMap.clear();
+	//Reset energy of all layers
+	if ( !layerEdep.empty() )
+		std::memset( &layerEdep[0], 0, layerEdep.size()*sizeof(G4double) );
 }
 
 void HadCaloSensitiveDetector::EndOfEvent(G4HCofThisEvent*)
 {
+	//Publish one hit for each layer with energy
+	for ( size_t layer = 0 ; layer < layerEdep.size() ; ++layer )
+	{
+		if ( layerEdep[layer] == 0 ) continue;
+		HadCaloHit* aHit = new HadCaloHit(layer);
+		aHit->AddEdep( layerEdep[layer] );
+		hitCollection->insert(aHit);
+	}
+
 	//--------------
 	//Exercise 1 of task4c
 	//---------------
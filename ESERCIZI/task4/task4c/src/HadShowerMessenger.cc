@@ -0,0 +1,97 @@
+/*
+ * HadShowerMessenger.cc
+ */
+
+/**
+ * @file
+ * @brief Implements class HadShowerMessenger
+ */
+
+#include "HadShowerMessenger.hh"
+#include "HadShowerProfile.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+HadShowerMessenger::HadShowerMessenger(HadShowerProfile* theProfile) :
+	profile(theProfile)
+{
+	showerDir = new G4UIdirectory("/hadshower/");
+	showerDir->SetGuidance("fast simulation of hadronic showers in the HAD calo");
+
+	loadCmd = new G4UIcmdWithAString("/hadshower/load",this);
+	loadCmd->SetGuidance("Read the shower parameters from a file: this enables the fast simulation");
+	loadCmd->SetParameterName("file",false);
+	loadCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	saveCmd = new G4UIcmdWithAString("/hadshower/save",this);
+	saveCmd->SetGuidance("Write the shower parameters to a file");
+	saveCmd->SetParameterName("file",false);
+	saveCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	recordCmd = new G4UIcmdWithABool("/hadshower/record",this);
+	recordCmd->SetGuidance("Fit the shower parameters from the next runs (full simulation, one run per energy)");
+	recordCmd->SetParameterName("record",true);
+	recordCmd->SetDefaultValue(true);
+	recordCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	minEnergyCmd = new G4UIcmdWithADoubleAndUnit("/hadshower/minEnergy",this);
+	minEnergyCmd->SetGuidance("Hadrons above this kinetic energy are parameterised");
+	minEnergyCmd->SetParameterName("energy",false);
+	minEnergyCmd->SetRange("energy>=0.");
+	minEnergyCmd->SetUnitCategory("Energy");
+	minEnergyCmd->SetDefaultUnit("GeV");
+	minEnergyCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	spotsCmd = new G4UIcmdWithAnInteger("/hadshower/spots",this);
+	spotsCmd->SetGuidance("Number of energy spots deposited per shower");
+	spotsCmd->SetParameterName("spots",false);
+	spotsCmd->SetRange("spots>0");
+	spotsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	clearCmd = new G4UIcmdWithoutParameter("/hadshower/clear",this);
+	clearCmd->SetGuidance("Remove all parameters: this disables the fast simulation");
+	clearCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	listCmd = new G4UIcmdWithoutParameter("/hadshower/list",this);
+	listCmd->SetGuidance("Print the shower parameters");
+}
+
+HadShowerMessenger::~HadShowerMessenger()
+{
+	delete loadCmd;
+	delete saveCmd;
+	delete recordCmd;
+	delete minEnergyCmd;
+	delete spotsCmd;
+	delete clearCmd;
+	delete listCmd;
+	delete showerDir;
+}
+
+void HadShowerMessenger::SetNewValue(G4UIcommand* cmd,G4String newValue)
+{
+	if ( cmd == loadCmd )
+		profile->Load(newValue);
+
+	if ( cmd == saveCmd )
+		profile->Save(newValue);
+
+	if ( cmd == recordCmd )
+		profile->SetRecording( recordCmd->GetNewBoolValue(newValue) );
+
+	if ( cmd == minEnergyCmd )
+		profile->SetMinEnergy( minEnergyCmd->GetNewDoubleValue(newValue) );
+
+	if ( cmd == spotsCmd )
+		profile->SetNumberOfSpots( spotsCmd->GetNewIntValue(newValue) );
+
+	if ( cmd == clearCmd )
+		profile->Clear();
+
+	if ( cmd == listCmd )
+		profile->List();
+}
@@ -0,0 +1,95 @@
+/*
+ * HadShowerModel.cc
+ */
+
+/**
+ * @file
+ * @brief Implements class HadShowerModel
+ */
+
+#include "HadShowerModel.hh"
+#include "HadShowerProfile.hh"
+#include "HadCaloSensitiveDetector.hh"
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+
+HadShowerModel::HadShowerModel(const G4String& name, G4Region* envelope, HadCaloSensitiveDetector* sd) :
+	G4VFastSimulationModel(name,envelope),
+	sensitive(sd)
+{
+	//Create the parameters now so that the UI commands are available
+	HadShowerProfile::GetInstance();
+}
+
+HadShowerModel::~HadShowerModel()
+{
+}
+
+G4bool HadShowerModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+	return particle.GetParticleType() == "baryon" || particle.GetParticleType() == "meson";
+}
+
+G4bool HadShowerModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+	HadShowerProfile* profile = HadShowerProfile::GetInstance();
+	//The profile is along z: only hadrons moving forward
+	if ( fastTrack.GetPrimaryTrackLocalDirection().z() <= 0 ) return false;
+	G4double energy = fastTrack.GetPrimaryTrack()->GetKineticEnergy();
+	if ( energy <= profile->GetMinEnergy() ) return false;
+	if ( profile->IsRecording() )
+	{
+		//Full simulation: the hadrons the model would take are only recorded,
+		//the fit is done against their energy and depth in the calo
+		G4double depth = fastTrack.GetPrimaryTrackLocalPosition().z() + profile->GetTotalThickness()/2;
+		profile->RecordEntry(energy,depth);
+		return false;
+	}
+	return profile->HasParameters();
+}
+
+void HadShowerModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+	const HadShowerProfile* profile = HadShowerProfile::GetInstance();
+	G4double energy = fastTrack.GetPrimaryTrack()->GetKineticEnergy();
+	HadShowerProfile::Parameters par = profile->Interpolate(energy);
+
+	//Visible fraction and barycenter depth of this shower: the two gaussians
+	//are correlated through the electromagnetic fraction of the shower
+	G4double g1 = CLHEP::RandGauss::shoot();
+	G4double g2 = CLHEP::RandGauss::shoot();
+	G4double rho = std::max( -1. , std::min( 1. , par.correlation ) );
+	G4double visible = std::max( 0. , par.visMean + par.visSigma*g1 );
+	G4double depth = par.depthMean + par.depthSigma*( rho*g1 + std::sqrt(1-rho*rho)*g2 );
+	depth = std::max( depth , 1*mm );
+
+	//Spots are distributed in depth (z) from the entry point with a gamma
+	//profile of mean depth and relative width given by the parameters:
+	//HadShowerProfile fits them in z, whatever the direction of the hadron
+	G4double width = std::max( par.width , 0.05 );
+	G4double shape = 1/(width*width);
+	G4double rate = shape/depth;
+	G4ThreeVector position = fastTrack.GetPrimaryTrackLocalPosition();
+	G4double entryDepth = position.z() + profile->GetTotalThickness()/2;
+	G4int numSpots = profile->GetNumberOfSpots();
+	G4double spotEnergy = visible*energy/numSpots;
+	for ( G4int spot = 0 ; spot < numSpots ; ++spot )
+	{
+		G4double spotDepth = CLHEP::RandGamma::shoot(shape,rate);
+		G4int layer = profile->FindLayer( entryDepth + spotDepth );
+		//Spots beyond the back of the calo are leakage
+		if ( layer >= 0 ) sensitive->AddLayerEnergy(layer,spotEnergy);
+	}
+
+	//The hadron and its shower end here. The energy is in the spots only: no
+	//deposit is proposed for the step, the SD would count it again when the
+	//model is triggered inside a LAr layer
+	fastStep.KillPrimaryTrack();
+	fastStep.ProposePrimaryTrackPathLength(0);
+}
@@ -0,0 +1,38 @@
+/*
+ * HadShowerPhysics.cc
+ */
+
+/**
+ * @file
+ * @brief Implements class HadShowerPhysics
+ */
+
+#include "HadShowerPhysics.hh"
+#include "G4FastSimulationManagerProcess.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ProcessManager.hh"
+
+HadShowerPhysics::HadShowerPhysics(const G4String& name) :
+	G4VPhysicsConstructor(name)
+{
+}
+
+HadShowerPhysics::~HadShowerPhysics()
+{
+}
+
+void HadShowerPhysics::ConstructProcess()
+{
+	G4FastSimulationManagerProcess* fastSimProcess =
+		new G4FastSimulationManagerProcess("G4FSMP_hadshower");
+
+	theParticleIterator->reset();
+	while ( (*theParticleIterator)() )
+	{
+		G4ParticleDefinition* particle = theParticleIterator->value();
+		G4ProcessManager* pmanager = particle->GetProcessManager();
+		if ( pmanager == 0 || particle->IsShortLived() ) continue;
+		if ( particle->GetParticleType() == "baryon" || particle->GetParticleType() == "meson" )
+			pmanager->AddDiscreteProcess(fastSimProcess);
+	}
+}
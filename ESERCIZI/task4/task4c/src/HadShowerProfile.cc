@@ -0,0 +1,225 @@
+/*
+ * HadShowerProfile.cc
+ */
+
+#include "HadShowerProfile.hh"
+#include "HadShowerMessenger.hh"
+#include "G4UnitsTable.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+HadShowerProfile* HadShowerProfile::singleton = 0;
+
+HadShowerProfile::HadShowerProfile() :
+	minEnergy(1*GeV),
+	numSpots(200),
+	recording(false)
+{
+	messenger = new HadShowerMessenger(this);
+	PrepareNewRun();
+	PrepareNewEvent();
+}
+
+HadShowerProfile::~HadShowerProfile()
+{
+	delete messenger;
+}
+
+void HadShowerProfile::SetLayers( const std::vector<G4double>& absorberThickness,
+								  const std::vector<G4double>& activeThickness )
+{
+	size_t numLayers = std::min( absorberThickness.size() , activeThickness.size() );
+	layerBack.resize(numLayers);
+	activeCenter.resize(numLayers);
+	G4double depth = 0;
+	for ( size_t layerIdx = 0 ; layerIdx < numLayers ; ++layerIdx )
+	{
+		depth += absorberThickness[layerIdx];
+		activeCenter[layerIdx] = depth + activeThickness[layerIdx]/2;
+		depth += activeThickness[layerIdx];
+		layerBack[layerIdx] = depth;
+	}
+}
+
+G4int HadShowerProfile::FindLayer( G4double depth ) const
+{
+	if ( depth < 0 ) return -1;
+	//Layers are contiguous: the first back face beyond depth is the layer
+	std::vector<G4double>::const_iterator it =
+		std::upper_bound( layerBack.begin() , layerBack.end() , depth );
+	if ( it == layerBack.end() ) return -1;
+	return it - layerBack.begin();
+}
+
+HadShowerProfile::Parameters HadShowerProfile::Interpolate( G4double energy ) const
+{
+	//Outside the table the closest entry is used
+	if ( energy <= table.front().energy ) return table.front();
+	if ( energy >= table.back().energy ) return table.back();
+	size_t high = 1;
+	while ( table[high].energy < energy ) ++high;
+	const Parameters& p1 = table[high-1];
+	const Parameters& p2 = table[high];
+	G4double f = std::log(energy/p1.energy) / std::log(p2.energy/p1.energy);
+	Parameters par;
+	par.energy      = energy;
+	par.visMean     = p1.visMean     + f*(p2.visMean-p1.visMean);
+	par.visSigma    = p1.visSigma    + f*(p2.visSigma-p1.visSigma);
+	par.depthMean   = p1.depthMean   + f*(p2.depthMean-p1.depthMean);
+	par.depthSigma  = p1.depthSigma  + f*(p2.depthSigma-p1.depthSigma);
+	par.correlation = p1.correlation + f*(p2.correlation-p1.correlation);
+	par.width       = p1.width       + f*(p2.width-p1.width);
+	return par;
+}
+
+void HadShowerProfile::Insert( const Parameters& par )
+{
+	std::vector<Parameters>::iterator it = table.begin();
+	for ( ; it != table.end() ; ++it )
+	{
+		if ( std::fabs(it->energy - par.energy) < 1e-3*par.energy )
+		{
+			*it = par;
+			return;
+		}
+		if ( it->energy > par.energy ) break;
+	}
+	table.insert(it,par);
+}
+
+void HadShowerProfile::PrepareNewRun()
+{
+	numEvents = 0;
+	sumEnergy = 0;
+	sumVis = sumVis2 = 0;
+	sumDepth = sumDepth2 = 0;
+	sumVisDepth = 0;
+	sumWidth = 0;
+}
+
+void HadShowerProfile::RecordEntry( G4double energy, G4double depth )
+{
+	if ( energy <= entryEnergy ) return;
+	entryEnergy = energy;
+	entryDepth = depth;
+}
+
+void HadShowerProfile::AddEvent( const G4double* layerEdep, G4int numLayers )
+{
+	//No hadron reached the calo above the threshold of the model
+	if ( !recording || entryEnergy <= 0 ) return;
+	const G4double energy = entryEnergy;
+	numLayers = std::min( numLayers , static_cast<G4int>(activeCenter.size()) );
+	//Moments of the longitudinal profile of this event
+	G4double vis = 0, depth = 0, depth2 = 0;
+	for ( G4int layer = 0 ; layer < numLayers ; ++layer )
+	{
+		vis += layerEdep[layer];
+		depth += layerEdep[layer]*activeCenter[layer];
+		depth2 += layerEdep[layer]*activeCenter[layer]*activeCenter[layer];
+	}
+	if ( vis <= 0 ) return;
+	depth /= vis;
+	G4double rms = std::sqrt( std::max( depth2/vis - depth*depth , 0. ) );
+	//The model starts the shower where the hadron enters the calo
+	depth -= entryDepth;
+	if ( depth <= 0 ) return;
+	vis /= energy;
+
+	++numEvents;
+	sumEnergy += energy;
+	sumVis += vis;
+	sumVis2 += vis*vis;
+	sumDepth += depth;
+	sumDepth2 += depth*depth;
+	sumVisDepth += vis*depth;
+	sumWidth += rms/depth;
+}
+
+void HadShowerProfile::EndOfRun()
+{
+	if ( !recording ) return;
+	if ( numEvents < 2 )
+	{
+		G4cerr<<"HadShowerProfile: not enough events with energy in the HAD calo, no parameters"<<G4endl;
+		return;
+	}
+	Parameters par;
+	par.energy = sumEnergy/numEvents;
+	par.visMean = sumVis/numEvents;
+	par.visSigma = std::sqrt( std::max( sumVis2/numEvents - par.visMean*par.visMean , 0. ) );
+	par.depthMean = sumDepth/numEvents;
+	par.depthSigma = std::sqrt( std::max( sumDepth2/numEvents - par.depthMean*par.depthMean , 0. ) );
+	G4double covariance = sumVisDepth/numEvents - par.visMean*par.depthMean;
+	par.correlation = ( par.visSigma > 0 && par.depthSigma > 0 ) ?
+			covariance/(par.visSigma*par.depthSigma) : 0;
+	par.width = sumWidth/numEvents;
+	Insert(par);
+	G4cout<<"HadShowerProfile: parameters for E="<<G4BestUnit(par.energy,"Energy")
+		  <<" from "<<numEvents<<" events"<<G4endl;
+	List();
+}
+
+G4bool HadShowerProfile::Load( const G4String& fileName )
+{
+	std::ifstream in(fileName.c_str());
+	if ( !in )
+	{
+		G4cerr<<"HadShowerProfile: cannot open "<<fileName<<G4endl;
+		return false;
+	}
+	table.clear();
+	std::string line;
+	while ( std::getline(in,line) )
+	{
+		if ( line.empty() || line[0] == '#' ) continue;
+		std::istringstream fields(line);
+		Parameters par;
+		fields>>par.energy>>par.visMean>>par.visSigma>>par.depthMean
+			  >>par.depthSigma>>par.correlation>>par.width;
+		if ( fields.fail() ) continue;
+		par.energy *= GeV;
+		par.depthMean *= mm;
+		par.depthSigma *= mm;
+		Insert(par);
+	}
+	G4cout<<"HadShowerProfile: "<<table.size()<<" energies read from "<<fileName<<G4endl;
+	return HasParameters();
+}
+
+G4bool HadShowerProfile::Save( const G4String& fileName ) const
+{
+	std::ofstream out(fileName.c_str());
+	if ( !out )
+	{
+		G4cerr<<"HadShowerProfile: cannot write "<<fileName<<G4endl;
+		return false;
+	}
+	out<<"# E[GeV] visMean visSigma depthMean[mm] depthSigma[mm] correlation width"<<std::endl;
+	for ( size_t i = 0 ; i < table.size() ; ++i )
+	{
+		const Parameters& par = table[i];
+		out<<par.energy/GeV<<" "<<par.visMean<<" "<<par.visSigma<<" "
+		   <<par.depthMean/mm<<" "<<par.depthSigma/mm<<" "
+		   <<par.correlation<<" "<<par.width<<std::endl;
+	}
+	return true;
+}
+
+void HadShowerProfile::List() const
+{
+	G4cout<<"Hadronic shower parameters (fast simulation above "
+		  <<G4BestUnit(minEnergy,"Energy")<<", "<<numSpots<<" spots):"<<G4endl;
+	for ( size_t i = 0 ; i < table.size() ; ++i )
+	{
+		const Parameters& par = table[i];
+		G4cout<<"\t E="<<G4BestUnit(par.energy,"Energy")
+			  <<" visible fraction="<<par.visMean<<" +- "<<par.visSigma
+			  <<" depth="<<G4BestUnit(par.depthMean,"Length")<<" +- "<<G4BestUnit(par.depthSigma,"Length")
+			  <<" correlation="<<par.correlation
+			  <<" width="<<par.width<<G4endl;
+	}
+}
@@ -0,0 +1,122 @@
+/*
+ * LayerProfileWriter.cc
+ */
+
+/**
+ * @file
+ * @brief Implements class LayerProfileWriter
+ */
+
+#include "LayerProfileWriter.hh"
+#include "LayerProfileWriterMessenger.hh"
+
+#include <cmath>
+#include <sstream>
+
+namespace {
+	const unsigned short kVersion = 1;
+	const unsigned short kMaxValue = 0x7FFF;
+	const unsigned short kZeroRun = 0x8000;
+	const unsigned short kEscape = 0xFFFF;
+	//! Longest zero run in a single code
+	const G4int kMaxZeroRun = 0x7FFE;
+
+	template<class T> void WriteRaw( std::ofstream& out, const T& value )
+	{
+		out.write( reinterpret_cast<const char*>(&value) , sizeof(T) );
+	}
+}
+
+LayerProfileWriter::LayerProfileWriter() :
+	quantum(10*keV),
+	numLayersInFile(0),
+	eventsWritten(0),
+	bytesWritten(0),
+	overflows(0)
+{
+	messenger = new LayerProfileWriterMessenger(this);
+}
+
+LayerProfileWriter::~LayerProfileWriter()
+{
+	Close();
+	delete messenger;
+}
+
+void LayerProfileWriter::Open( G4int runID, G4int numLayers )
+{
+	Close();
+	if ( filePrefix.empty() ) return;
+	std::ostringstream fileName;
+	fileName<<filePrefix<<"_run"<<runID<<".dat";
+	out.open( fileName.str().c_str() , std::ios::binary );
+	if ( !out )
+	{
+		G4cerr<<"LayerProfileWriter: cannot write "<<fileName.str()<<G4endl;
+		return;
+	}
+	numLayersInFile = numLayers;
+	eventsWritten = 0;
+	overflows = 0;
+	out.write("L16P",4);
+	WriteRaw( out , kVersion );
+	WriteRaw( out , static_cast<unsigned short>(numLayers) );
+	WriteRaw( out , static_cast<double>(quantum/MeV) );
+	bytesWritten = 4 + 2*sizeof(unsigned short) + sizeof(double);
+	codes.reserve( 3*numLayers );
+	G4cout<<"LayerProfileWriter: writing layer energies to "<<fileName.str()<<G4endl;
+}
+
+void LayerProfileWriter::AddEvent( G4int eventID, const G4double* layerEdep, G4int numLayers )
+{
+	if ( !out.is_open() ) return;
+	codes.clear();
+	G4int zeros = 0;
+	for ( G4int layer = 0 ; layer < numLayers ; ++layer )
+	{
+		unsigned long quanta = static_cast<unsigned long>( std::floor( layerEdep[layer]/quantum + 0.5 ) );
+		if ( quanta == 0 )
+		{
+			++zeros;
+			continue;
+		}
+		//Empty layers before this one
+		while ( zeros > 0 )
+		{
+			G4int run = std::min( zeros , kMaxZeroRun );
+			codes.push_back( static_cast<unsigned short>(kZeroRun | run) );
+			zeros -= run;
+		}
+		if ( quanta <= kMaxValue )
+			codes.push_back( static_cast<unsigned short>(quanta) );
+		else
+		{
+			if ( quanta > 0xFFFFFFFFUL ) quanta = 0xFFFFFFFFUL;
+			codes.push_back( kEscape );
+			codes.push_back( static_cast<unsigned short>(quanta & 0xFFFF) );
+			codes.push_back( static_cast<unsigned short>(quanta >> 16) );
+			++overflows;
+		}
+	}
+	//Trailing empty layers are not written
+	WriteRaw( out , static_cast<unsigned int>(eventID) );
+	WriteRaw( out , static_cast<unsigned short>(codes.size()) );
+	if ( !codes.empty() )
+		out.write( reinterpret_cast<const char*>(&codes[0]) , codes.size()*sizeof(unsigned short) );
+	bytesWritten += sizeof(unsigned int) + sizeof(unsigned short) + codes.size()*sizeof(unsigned short);
+	++eventsWritten;
+}
+
+void LayerProfileWriter::Close()
+{
+	if ( !out.is_open() ) return;
+	out.close();
+	G4double plainBytes = static_cast<G4double>(eventsWritten)*numLayersInFile*sizeof(G4double);
+	G4cout<<"LayerProfileWriter: "<<eventsWritten<<" events, "<<bytesWritten<<" bytes";
+	if ( bytesWritten > 0 )
+		G4cout<<" (1/"<<plainBytes/bytesWritten<<" of "<<numLayersInFile<<" doubles per event)";
+	G4cout<<G4endl;
+	if ( overflows > 0 )
+		G4cout<<"LayerProfileWriter: "<<overflows<<" layers above "<<kMaxValue
+			  <<" quanta, consider a larger /layers/quantum"<<G4endl;
+}
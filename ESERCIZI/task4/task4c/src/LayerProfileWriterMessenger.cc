@@ -0,0 +1,50 @@
+/*
+ * LayerProfileWriterMessenger.cc
+ */
+
+/**
+ * @file
+ * @brief Implements class LayerProfileWriterMessenger
+ */
+
+#include "LayerProfileWriterMessenger.hh"
+#include "LayerProfileWriter.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+LayerProfileWriterMessenger::LayerProfileWriterMessenger(LayerProfileWriter* theWriter) :
+	writer(theWriter)
+{
+	layersDir = new G4UIdirectory("/layers/");
+	layersDir->SetGuidance("event by event output of the HAD calo layers energy");
+
+	fileCmd = new G4UIcmdWithAString("/layers/file",this);
+	fileCmd->SetGuidance("Prefix of the output files (<prefix>_run<N>.dat), none to disable");
+	fileCmd->SetParameterName("prefix",false);
+	fileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	quantumCmd = new G4UIcmdWithADoubleAndUnit("/layers/quantum",this);
+	quantumCmd->SetGuidance("Energy quantum of the stored values: energies are stored within half a quantum");
+	quantumCmd->SetParameterName("quantum",false);
+	quantumCmd->SetRange("quantum>0.");
+	quantumCmd->SetUnitCategory("Energy");
+	quantumCmd->SetDefaultUnit("keV");
+	quantumCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+LayerProfileWriterMessenger::~LayerProfileWriterMessenger()
+{
+	delete fileCmd;
+	delete quantumCmd;
+	delete layersDir;
+}
+
+void LayerProfileWriterMessenger::SetNewValue(G4UIcommand* cmd,G4String newValue)
+{
+	if ( cmd == fileCmd )
+		writer->SetFilePrefix( newValue == "none" ? G4String("") : newValue );
+
+	if ( cmd == quantumCmd )
+		writer->SetQuantum( quantumCmd->GetNewDoubleValue(newValue) );
+}
@@ -10,20 +10,39 @@
 
 #include "RunAction.hh"
 #include "G4Run.hh"
+#include "ProgressReporter.hh"
+#include "StepProfiler.hh"
 #include "G4RunManager.hh"
 #include "Analysis.hh"
+#include "TrackKiller.hh"
+#include "HadShowerProfile.hh"
 
 RunAction::RunAction()
 {
+	//Create the reporter and the profiler now so that their UI commands
+	//are available
+	ProgressReporter::GetInstance();
+	StepProfiler::GetInstance();
+	//Analysis owns the layers output: its /layers/ commands must exist
+	//before the first run
+	Analysis::GetInstance();
 }
 
 void RunAction::BeginOfRunAction(const G4Run* aRun )
 {
+	StepProfiler::GetInstance()->BeginOfRun();
+	ProgressReporter::GetInstance()->BeginOfRun(aRun->GetNumberOfEventToBeProcessed());
 	G4cout<<"Starting Run: "<<aRun->GetRunID()<<G4endl;
 	Analysis::GetInstance()->PrepareNewRun(aRun);
+	TrackKiller::GetInstance()->PrepareNewRun();
+	HadShowerProfile::GetInstance()->PrepareNewRun();
 }
 
 void RunAction::EndOfRunAction( const G4Run* aRun )
 {
+	StepProfiler::GetInstance()->EndOfRun();
+	ProgressReporter::GetInstance()->EndOfRun();
 	Analysis::GetInstance()->EndOfRun(aRun);
+	TrackKiller::GetInstance()->EndOfRun(aRun->GetNumberOfEvent());
+	HadShowerProfile::GetInstance()->EndOfRun();
 }
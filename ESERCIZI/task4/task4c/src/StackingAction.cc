@@ -2,6 +2,7 @@
 #include "G4ClassificationOfNewTrack.hh"
 #include "G4Track.hh"
 #include "Analysis.hh"
+#include "TrackKiller.hh"
 //#include "G4TrackStatus.hh"
 //#include "G4ParticleDefinition.hh"
 //#include "G4ParticleTypes.hh"
@@ -15,6 +16,8 @@
 
 StackingAction::StackingAction()
 {
+	//Create the killer now so that its UI commands are available
+	TrackKiller::GetInstance();
 }
 
 
@@ -29,6 +32,9 @@ StackingAction::ClassifyNewTrack( const G4Track * aTrack ) {
   if ( aTrack->GetParentID() > 0 )//This is a secondary
   {
 		Analysis::GetInstance()->AddSecondary(1);
+		//Slow neutrons and late tracks can be killed as soon as they are created
+		TrackKiller* killer = TrackKiller::GetInstance();
+		if ( killer->IsActive() && killer->KillNewTrack(aTrack) ) result = fKill;
   }
 
  // G4ParticleDefinition * particleType = aTrack->GetDefinition();
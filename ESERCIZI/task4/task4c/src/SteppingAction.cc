@@ -1,15 +1,18 @@
 #include "SteppingAction.hh"
 //#include "G4Track.hh"
 #include "G4Step.hh"
+#include "ProgressReporter.hh"
+#include "StepProfiler.hh"
 //#include "G4ParticleDefinition.hh"
 //#include "G4ParticleTypes.hh"
 //#include "G4StepPoint.hh"
-//#include "G4VPhysicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
 #include "G4VTouchable.hh"
 //#include "G4TouchableHistory.hh"
 #include "G4SteppingManager.hh"
 #include "G4UnitsTable.hh"
 #include "Analysis.hh"
+#include "TrackKiller.hh"
 
 SteppingAction::SteppingAction()
 {
@@ -20,6 +23,9 @@ SteppingAction::~SteppingAction()
 }
 
 void SteppingAction::UserSteppingAction( const G4Step * theStep ) {
+	ProgressReporter::GetInstance()->AddStep();
+	StepProfiler* profiler = StepProfiler::GetInstance();
+	if ( profiler->IsEnabled() ) profiler->AddStep(theStep);
 	//Check if this is the first step of this event,
 	//in this case print out info and prepare for next event
 	//Ask the stepping manager if this is the first step of this
@@ -36,10 +42,17 @@ void SteppingAction::UserSteppingAction( const G4Step * theStep ) {
 	//We could have asked the volume name, but string
 	//comparison is not efficient
 	const G4VTouchable* touchable = theStep->GetPreStepPoint()->GetTouchable();
-	G4int volCopyNum = touchable->GetVolume()->GetCopyNo();
-	if ( volCopyNum > 9 && volCopyNum  < 100 ) //EM calo step
+	//The HAD calo layers are one parameterised volume whose copy number is
+	//the layer index (0-N): they are excluded. The Si strip replicas keep
+	//the accounting they always had (strips 10-99 are counted)
+	G4VPhysicalVolume* volume = touchable->GetVolume();
+	G4int volCopyNum = volume->GetCopyNo();
+	if ( !volume->IsParameterised() && volCopyNum > 9 && volCopyNum  < 100 ) //EM calo step
 	{
 		Analysis::GetInstance()->AddEDepEM( theStep->GetTotalEnergyDeposit() );
 	}
+	//Kill slow neutrons and late tracks if requested
+	TrackKiller* killer = TrackKiller::GetInstance();
+	if ( killer->IsActive() ) killer->CheckStep( theStep );
 }
 
@@ -0,0 +1,125 @@
+/*
+ * TrackKiller.cc
+ */
+
+#include "TrackKiller.hh"
+#include "TrackKillerMessenger.hh"
+#include "G4Track.hh"
+#include "G4Step.hh"
+#include "G4Neutron.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4UnitsTable.hh"
+
+TrackKiller* TrackKiller::singleton = 0;
+
+TrackKiller::TrackKiller() :
+	currentRegion("DefaultRegionForTheWorld")
+{
+	messenger = new TrackKillerMessenger(this);
+}
+
+TrackKiller::~TrackKiller()
+{
+	delete messenger;
+}
+
+void TrackKiller::PrepareNewRun()
+{
+	//Regions are looked up by name once per run, then by pointer at each step
+	regionCuts.clear();
+	G4RegionStore* store = G4RegionStore::GetInstance();
+	std::map<G4String,Cuts>::const_iterator it = cuts.begin();
+	for ( ; it != cuts.end() ; ++it )
+	{
+		const G4Region* region = store->GetRegion(it->first,false);
+		if ( region == 0 )
+		{
+			G4cerr<<"TrackKiller: region "<<it->first<<" not found, cuts ignored"<<G4endl;
+			continue;
+		}
+		regionCuts.push_back( RegionCuts(region,it->second) );
+	}
+}
+
+TrackKiller::RegionCuts* TrackKiller::FindCuts( const G4Track* aTrack )
+{
+	const G4VPhysicalVolume* volume = aTrack->GetVolume();
+	if ( volume == 0 ) return 0;
+	const G4Region* region = volume->GetLogicalVolume()->GetRegion();
+	for ( size_t i = 0 ; i < regionCuts.size() ; ++i )
+		if ( regionCuts[i].region == region ) return &(regionCuts[i]);
+	return 0;
+}
+
+void TrackKiller::Kill( RegionCuts* regCuts , const G4Track* aTrack , G4bool byTime )
+{
+	if ( byTime )
+	{
+		++regCuts->numKilledLate;
+		regCuts->energyKilledLate += aTrack->GetKineticEnergy();
+	}
+	else
+	{
+		++regCuts->numKilledNeutrons;
+		regCuts->energyKilledNeutrons += aTrack->GetKineticEnergy();
+	}
+}
+
+G4bool TrackKiller::KillNewTrack( const G4Track* aTrack )
+{
+	RegionCuts* regCuts = FindCuts(aTrack);
+	if ( regCuts == 0 ) return false;
+	if ( aTrack->GetGlobalTime() > regCuts->cuts.time )
+	{
+		Kill(regCuts,aTrack,true);
+		return true;
+	}
+	if ( aTrack->GetDefinition() == G4Neutron::Neutron() &&
+		 aTrack->GetKineticEnergy() < regCuts->cuts.neutronEnergy )
+	{
+		Kill(regCuts,aTrack,false);
+		return true;
+	}
+	return false;
+}
+
+void TrackKiller::CheckStep( const G4Step* aStep )
+{
+	G4Track* aTrack = aStep->GetTrack();
+	if ( aTrack->GetTrackStatus() != fAlive ) return;
+	if ( KillNewTrack(aTrack) ) aTrack->SetTrackStatus(fStopAndKill);
+}
+
+void TrackKiller::ListCuts() const
+{
+	G4cout<<"TrackKiller cuts:"<<G4endl;
+	std::map<G4String,Cuts>::const_iterator it = cuts.begin();
+	for ( ; it != cuts.end() ; ++it )
+	{
+		G4cout<<"\t Region "<<it->first<<": neutron energy < "
+			  <<G4BestUnit(it->second.neutronEnergy,"Energy");
+		if ( it->second.time < DBL_MAX )
+			G4cout<<", global time > "<<G4BestUnit(it->second.time,"Time");
+		G4cout<<G4endl;
+	}
+}
+
+void TrackKiller::EndOfRun(G4int numEvents)
+{
+	if ( !IsActive() || numEvents == 0 ) return;
+	G4cout<<"================="<<G4endl;
+	G4cout<<"Killed tracks summary"<<G4endl;
+	for ( size_t i = 0 ; i < regionCuts.size() ; ++i )
+	{
+		const RegionCuts& reg = regionCuts[i];
+		G4cout<<"\t Region "<<reg.region->GetName()<<G4endl;
+		G4cout<<"\t\t Slow neutrons killed per event: "<<(G4double)reg.numKilledNeutrons/numEvents
+			  <<", kinetic energy per event: "<<G4BestUnit(reg.energyKilledNeutrons/numEvents,"Energy")<<G4endl;
+		G4cout<<"\t\t Late tracks killed per event: "<<(G4double)reg.numKilledLate/numEvents
+			  <<", kinetic energy per event: "<<G4BestUnit(reg.energyKilledLate/numEvents,"Energy")<<G4endl;
+	}
+	G4cout<<"================="<<G4endl;
+}
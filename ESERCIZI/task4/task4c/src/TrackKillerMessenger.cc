@@ -0,0 +1,72 @@
+/*
+ * TrackKillerMessenger.cc
+ */
+
+/**
+ * @file
+ * @brief Implements class TrackKillerMessenger
+ */
+
+#include "TrackKillerMessenger.hh"
+#include "TrackKiller.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+TrackKillerMessenger::TrackKillerMessenger(TrackKiller* theKiller) :
+	killer(theKiller)
+{
+	killerDir = new G4UIdirectory("/killer/");
+	killerDir->SetGuidance("kill slow neutrons and late tracks in a region");
+
+	regionCmd = new G4UIcmdWithAString("/killer/region",this);
+	regionCmd->SetGuidance("Select the region the following cuts apply to (e.g. HadCalo)");
+	regionCmd->SetParameterName("region",false);
+	regionCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	neutronEnergyCmd = new G4UIcmdWithADoubleAndUnit("/killer/neutronEnergy",this);
+	neutronEnergyCmd->SetGuidance("Kill neutrons below this kinetic energy in the selected region (0 to disable)");
+	neutronEnergyCmd->SetParameterName("energy",false);
+	neutronEnergyCmd->SetRange("energy>=0.");
+	neutronEnergyCmd->SetUnitCategory("Energy");
+	neutronEnergyCmd->SetDefaultUnit("MeV");
+	neutronEnergyCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	timeCmd = new G4UIcmdWithADoubleAndUnit("/killer/timeCut",this);
+	timeCmd->SetGuidance("Kill tracks with global time above this value in the selected region (0 to disable)");
+	timeCmd->SetParameterName("time",false);
+	timeCmd->SetRange("time>=0.");
+	timeCmd->SetUnitCategory("Time");
+	timeCmd->SetDefaultUnit("ns");
+	timeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+	listCmd = new G4UIcmdWithoutParameter("/killer/list",this);
+	listCmd->SetGuidance("Print the cuts of all regions");
+}
+
+TrackKillerMessenger::~TrackKillerMessenger()
+{
+	delete regionCmd;
+	delete neutronEnergyCmd;
+	delete timeCmd;
+	delete listCmd;
+	delete killerDir;
+}
+
+void TrackKillerMessenger::SetNewValue(G4UIcommand* cmd,G4String newValue)
+{
+	if ( cmd == regionCmd )
+		killer->SelectRegion(newValue);
+
+	if ( cmd == neutronEnergyCmd )
+		killer->SetNeutronEnergyCut( neutronEnergyCmd->GetNewDoubleValue(newValue) );
+
+	if ( cmd == timeCmd ) {
+		G4double value = timeCmd->GetNewDoubleValue(newValue);
+		killer->SetTimeCut( value > 0 ? value : DBL_MAX );
+	}
+
+	if ( cmd == listCmd )
+		killer->ListCuts();
+}
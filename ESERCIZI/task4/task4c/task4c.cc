@@ -26,6 +26,7 @@
 
 #include "PhysicsList.hh"
 #include "QGSP_BERT.hh"
+#include "HadShowerPhysics.hh"
 
 #include "G4RadioactiveDecayPhysics.hh"
 
@@ -47,7 +48,9 @@ int main(int argc,char** argv)
   G4VUserDetectorConstruction* detector = new DetectorConstruction();
   runManager->SetUserInitialization(detector);
 
-  G4VUserPhysicsList* physics = new QGSP_BERT();//new PhysicsList();
+  QGSP_BERT* physics = new QGSP_BERT();//new PhysicsList();
+  //fast simulation of hadronic showers in the HAD calo (see /hadshower/)
+  physics->RegisterPhysics(new HadShowerPhysics());
   runManager->SetUserInitialization(physics);
 
   // mandatory User Action classes
@@ -14,155 +14,21 @@
  
 
 #include "ProcessClassify.hh"
+#include "../../../common/ParticleSpecies.hh"
 
 //GABRIELE
 
 string ProcessClassify::convertInt(Int_t number)
      
 {
-  //Create the table in order to covert the PDGEconding 
-  // to the symbol of the particle
-  
-  string tmps;
-
-  //gamma
-  if(number == 22) 
-    {
-      tmps = "g";
-    }
-  //proton
-  else if(number == 2212) 
-    {
-      tmps = "p";
-    }
-  //neutron
-  else if(number == 2112) 
-    {
-      tmps = "n";
-    }
-  //ArgonIon40
-  else if(number == 1000180400) 
-    {
-      tmps = "Ar40";
-    }
-  //ArgonIon36
-  else if(number == 1000180360) 
-    {
-      tmps = "Ar36";
-    }
-  //ArgonIon37
-  else if(number == 1000180370) 
-    {
-      tmps = "Ar37";
-    }
-  //ArgonIon38
-  else if(number == 1000180380) 
-    {
-      tmps = "Ar38";
-    }
-  //ArgonIon41
-  else if(number == 1000180410)
-    {
-      tmps = "Ar41";
-    }
-  //CarbonIon12
-  else if(number == 1000060120) 
-    { 
-      tmps = "C12";
-    }
-  //CarbonIon13
-  else if(number == 1000060130) 
-    { 
-      tmps = "C13";
-    }
-  //OxygenIon16
-  else if(number == 1000080160) 
-    {
-      tmps = "O16";
-    }
-  //OxygenIon17
-  else if(number == 1000080170) 
-    {
-      tmps = "O17";
-    }
-  //OxygenIon18
-  else if(number == 1000080180) 
-    {
-      tmps = "O18";
-    }
-  //CopperIon63
-  else if(number == 1000290630) 
-    {
-      tmps = "Cu63";
-    }
-  //CopperIon65
-  else if(number == 1000290650) 
-    { 
-      tmps = "Cu65";
-    }
-  //HeliumIon4
-  else if(number == 1000020040)
-    {
-      tmps = "He4";
-    }
-  //SulfurIon33
-  else if(number == 1000160330)
-    {
-      tmps = "S33";
-    }
-  //SulfurIon37
-  else if(number == 1000160370)
-    {
-      tmps = "S37";
-    }
-  //NichelIon63
-  else if(number == 1000280630)
-    {
-      tmps = "Ni63";
-    }
-  //ClorumIon36
-  else if(number == 1000170360)
-    {
-      tmps = "Cl36";
-    }
-  //DeuteriumIon
-  else if(number == 1000010020)
-    {
-      tmps = "H2";
-    }
-  //Germanium70
-  else if(number == 1000320700)
-    {
-      tmps = "Ge70";
-    }
-  //Germanium72
-  else if(number == 1000320720)
-    {
-      tmps = "Ge72";
-    }
-  //Germanium74
-  else if(number == 1000320740)
-    {
-      tmps = "Ge74";
-    }
-  //Germanium76
-  else if(number == 1000320760)
-    {
-      tmps = "Ge76";
-    }
-  
-  
-  else
-    {
-      
-      stringstream ss;//create a stringstream
-      ss << number;//add number to the stream
-      tmps = ss.str();
-    }
-  
-  return tmps;//return a string with the contents of the stream
-  
-
+  //Symbol of the particle from the PDGEncoding,
+  //see ParticleSpecies for the table
+  const char* name = ParticleSpecies::GetName(number);
+  if (name) return name;
+
+  stringstream ss;//create a stringstream
+  ss << number;//add number to the stream
+  return ss.str();//return a string with the contents of the stream
 }
 
 
@@ -0,0 +1,350 @@
+/**
+ * @file   GasTreeAnalysis.cc
+ *
+ * @brief  Implements class GasTreeAnalysis.
+ */
+
+#include "GasTreeAnalysis.hh"
+#include "TFile.h"
+#include "TTree.h"
+#include "TLeaf.h"
+#include "TH1D.h"
+#include "TDirectory.h"
+#include "TROOT.h"
+#include "RVersion.h"
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,0,0)
+#include "TThread.h"
+#endif
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+Double_t GasEvent::SumEdep() const
+{
+  Double_t sum = 0;
+  for ( Int_t i = 0 ; i < ntracks ; ++i )
+    if ( InPrimary(i) ) sum += edep[i];
+  return sum;
+}
+
+Double_t GasEvent::Weight() const
+{
+  Double_t sumEdep = 0, sumWEdep = 0;
+  for ( Int_t i = 0 ; i < ntracks ; ++i )
+    {
+      if ( !InPrimary(i) ) continue;
+      sumEdep += edep[i];
+      sumWEdep += w[i]*edep[i];
+    }
+  if ( sumEdep > 0 ) return sumWEdep/sumEdep;
+  //No energy deposited: weight of its first track
+  for ( Int_t i = 0 ; i < ntracks ; ++i )
+    if ( InPrimary(i) ) return w[i];
+  return 1;
+}
+
+Int_t GasEvent::FindTrack( Int_t trackID ) const
+{
+  const Int_t* end = id + ntracks;
+  const Int_t* track = std::lower_bound( id , end , trackID );
+  return ( track != end && *track == trackID ) ? static_cast<Int_t>( track - id ) : -1;
+}
+
+Histo1D::Histo1D( Int_t n , Double_t lo , Double_t hi ) :
+  nbins(n), xlow(lo), xup(hi),
+  content(n+2,0), sumw2(n+2,0),
+  entries(0)
+{
+}
+
+void Histo1D::Fill( Double_t x , Double_t w )
+{
+  Int_t bin;
+  if ( x < xlow ) bin = 0;
+  else if ( !(x < xup) ) bin = nbins+1;
+  else bin = 1 + static_cast<Int_t>( nbins*(x-xlow)/(xup-xlow) );
+  if ( bin > nbins ) bin = nbins+1; //rounding at the upper edge
+  content[bin] += w;
+  sumw2[bin] += w*w;
+  ++entries;
+}
+
+void Histo1D::Add( const Histo1D& other )
+{
+  for ( size_t bin = 0 ; bin < content.size() ; ++bin )
+    {
+      content[bin] += other.content[bin];
+      sumw2[bin] += other.sumw2[bin];
+    }
+  entries += other.entries;
+}
+
+void Histo1D::Write( const std::string& name ) const
+{
+  TH1D h( name.c_str() , name.c_str() , nbins , xlow , xup );
+  h.SetDirectory(0);
+  h.Sumw2();
+  for ( Int_t bin = 0 ; bin <= nbins+1 ; ++bin )
+    {
+      h.SetBinContent( bin , content[bin] );
+      h.SetBinError( bin , std::sqrt(sumw2[bin]) );
+    }
+  h.SetEntries( entries );
+  h.Write();
+}
+
+GasTreeAnalysis::GasTreeAnalysis( const std::string& tree ) :
+  treeName(tree),
+  nThreads(1),
+  chunkSize(100000),
+  nEntries(0),
+  nPrimaries(0)
+{
+}
+
+void GasTreeAnalysis::AddHisto( const std::string& name , Int_t nbins , Double_t lo , Double_t hi ,
+				Variable var , Selection sel )
+{
+  HistoDef def;
+  def.name = name;
+  def.nbins = nbins;
+  def.lo = lo;
+  def.hi = hi;
+  def.var = var;
+  def.sel = sel;
+  defs.push_back(def);
+}
+
+void GasTreeAnalysis::AddClassifier( const std::string& prefix , Int_t nbins , Double_t lo , Double_t hi ,
+				     Classifier key , Variable var , Selection sel )
+{
+  AddHisto( prefix , nbins , lo , hi , var , sel );
+  defs.back().key = key;
+}
+
+bool GasTreeAnalysis::Attach( TTree* tree , Buffers& buffers , GasEvent& event )
+{
+  if ( !tree->GetBranch("id") ) return false;
+  //Largest event of the file: the count leaf keeps its maximum
+  TLeaf* count = tree->GetLeaf("ntracks");
+  Int_t maxTracks = count ? count->GetMaximum() : 0;
+  if ( maxTracks <= 0 ) maxTracks = static_cast<Int_t>( tree->GetMaximum("ntracks") );
+  buffers.id.resize(maxTracks+1);
+  buffers.mum.resize(maxTracks+1);
+  buffers.type.resize(maxTracks+1);
+  buffers.edep.resize(maxTracks+1);
+  buffers.zp.resize(maxTracks+1);
+  buffers.t.resize(maxTracks+1);
+  //Defaults for the files written before the w and prim branches
+  buffers.w.assign(maxTracks+1,1);
+  buffers.prim.assign(maxTracks+1,0);
+
+  //Only the used branches are read
+  tree->SetBranchStatus( "*" , 0 );
+  const char* used[] = { "ntracks" , "id" , "mum" , "type" , "edep" , "zp" , "t" , "evid" };
+  for ( size_t b = 0 ; b < sizeof(used)/sizeof(used[0]) ; ++b )
+    tree->SetBranchStatus( used[b] , 1 );
+  if ( tree->GetBranch("w") )
+    {
+      tree->SetBranchStatus( "w" , 1 );
+      tree->SetBranchAddress( "w" , &buffers.w[0] );
+    }
+  if ( tree->GetBranch("prim") )
+    {
+      tree->SetBranchStatus( "prim" , 1 );
+      tree->SetBranchAddress( "prim" , &buffers.prim[0] );
+    }
+  tree->SetBranchAddress( "ntracks" , &event.ntracks );
+  tree->SetBranchAddress( "evid" , &event.evid );
+  tree->SetBranchAddress( "id" , &buffers.id[0] );
+  tree->SetBranchAddress( "mum" , &buffers.mum[0] );
+  tree->SetBranchAddress( "type" , &buffers.type[0] );
+  tree->SetBranchAddress( "edep" , &buffers.edep[0] );
+  tree->SetBranchAddress( "zp" , &buffers.zp[0] );
+  tree->SetBranchAddress( "t" , &buffers.t[0] );
+  event.id = &buffers.id[0];
+  event.mum = &buffers.mum[0];
+  event.type = &buffers.type[0];
+  event.edep = &buffers.edep[0];
+  event.zp = &buffers.zp[0];
+  event.t = &buffers.t[0];
+  event.w = &buffers.w[0];
+  event.prim = &buffers.prim[0];
+  event.primary = 0;
+  return true;
+}
+
+bool GasTreeAnalysis::MakeChunks( std::vector<Chunk>& chunks ) const
+{
+  for ( size_t f = 0 ; f < files.size() ; ++f )
+    {
+      std::unique_ptr<TFile> file( TFile::Open( files[f].c_str() ) );
+      TTree* tree = file && !file->IsZombie() ? dynamic_cast<TTree*>( file->Get( treeName.c_str() ) ) : 0;
+      if ( !tree )
+	{
+	  std::cerr<<"GasTreeAnalysis: no "<<treeName<<" in "<<files[f]<<std::endl;
+	  return false;
+	}
+      Long64_t entries = tree->GetEntries();
+      for ( Long64_t first = 0 ; first < entries ; first += chunkSize )
+	{
+	  Chunk chunk;
+	  chunk.file = f;
+	  chunk.first = first;
+	  chunk.n = std::min( chunkSize , entries-first );
+	  chunks.push_back(chunk);
+	}
+    }
+  return true;
+}
+
+void GasTreeAnalysis::Process( const Chunk& chunk , Result& result ) const
+{
+  result.ok = false;
+  result.entries = 0;
+  result.primaries = 0;
+  result.histos.clear();
+  result.keyed.assign( defs.size() , std::map<std::string,Histo1D>() );
+  for ( size_t d = 0 ; d < defs.size() ; ++d )
+    result.histos.push_back( Histo1D( defs[d].nbins , defs[d].lo , defs[d].hi ) );
+
+  std::unique_ptr<TFile> file( TFile::Open( files[chunk.file].c_str() ) );
+  TTree* tree = file && !file->IsZombie() ? dynamic_cast<TTree*>( file->Get( treeName.c_str() ) ) : 0;
+  if ( !tree || !tree->GetBranch("id") )
+    {
+      std::cerr<<"GasTreeAnalysis: cannot read the track arrays of "<<files[chunk.file]<<std::endl;
+      return;
+    }
+  Buffers buffers;
+  GasEvent event;
+  Attach( tree , buffers , event );
+  //Baskets of the chunk are read ahead in one go
+  tree->SetCacheSize( 10000000 );
+  tree->SetCacheEntryRange( chunk.first , chunk.first+chunk.n );
+  tree->AddBranchToCache( "*" , kTRUE );
+
+  std::vector<Int_t> primaries;
+  for ( Long64_t entry = chunk.first ; entry < chunk.first+chunk.n ; ++entry )
+    {
+      if ( tree->GetEntry(entry) <= 0 ) continue;
+      ++result.entries;
+      //Primaries with tracks in the gas, in increasing order
+      primaries.clear();
+      for ( Int_t i = 0 ; i < event.ntracks ; ++i )
+	if ( std::find( primaries.begin() , primaries.end() , event.prim[i] ) == primaries.end() )
+	  primaries.push_back( event.prim[i] );
+      std::sort( primaries.begin() , primaries.end() );
+      //Event without tracks in the gas: still one fill (edep 0), as before
+      if ( primaries.empty() ) primaries.push_back( 0 );
+      for ( size_t p = 0 ; p < primaries.size() ; ++p )
+	{
+	  event.primary = primaries[p];
+	  ++result.primaries;
+	  const Double_t weight = event.Weight();
+	  for ( size_t d = 0 ; d < defs.size() ; ++d )
+	    {
+	      const HistoDef& def = defs[d];
+	      if ( def.sel && !def.sel(event) ) continue;
+	      if ( !def.key )
+		{
+		  result.histos[d].Fill( def.var(event) , weight );
+		  continue;
+		}
+	      std::string key = def.key(event);
+	      if ( key.empty() ) continue;
+	      std::map<std::string,Histo1D>::iterator h = result.keyed[d].find(key);
+	      if ( h == result.keyed[d].end() )
+		h = result.keyed[d].insert( std::make_pair( key , Histo1D( def.nbins , def.lo , def.hi ) ) ).first;
+	      h->second.Fill( def.var(event) , weight );
+	    }
+	}
+    }
+  result.ok = true;
+}
+
+bool GasTreeAnalysis::Run()
+{
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+  ROOT::EnableThreadSafety();
+#else
+  TThread::Initialize();
+#endif
+  std::vector<Chunk> chunks;
+  if ( !MakeChunks(chunks) ) return false;
+
+  std::vector<Result> results( chunks.size() );
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    for ( size_t c = next++ ; c < chunks.size() ; c = next++ )
+      Process( chunks[c] , results[c] );
+  };
+  std::vector<std::thread> threads;
+  for ( Int_t i = 1 ; i < nThreads ; ++i ) threads.push_back( std::thread(worker) );
+  worker();
+  for ( size_t i = 0 ; i < threads.size() ; ++i ) threads[i].join();
+
+  //Deterministic merge: chunk order, then key order (std::map)
+  total.histos.clear();
+  total.keyed.assign( defs.size() , std::map<std::string,Histo1D>() );
+  for ( size_t d = 0 ; d < defs.size() ; ++d )
+    total.histos.push_back( Histo1D( defs[d].nbins , defs[d].lo , defs[d].hi ) );
+  total.ok = true;
+  nEntries = 0;
+  nPrimaries = 0;
+  for ( size_t c = 0 ; c < results.size() ; ++c )
+    {
+      const Result& res = results[c];
+      if ( !res.ok ) { total.ok = false; continue; }
+      nEntries += res.entries;
+      nPrimaries += res.primaries;
+      for ( size_t d = 0 ; d < defs.size() ; ++d )
+	{
+	  total.histos[d].Add( res.histos[d] );
+	  std::map<std::string,Histo1D>::const_iterator h = res.keyed[d].begin();
+	  for ( ; h != res.keyed[d].end() ; ++h )
+	    {
+	      std::map<std::string,Histo1D>::iterator sum = total.keyed[d].find(h->first);
+	      if ( sum == total.keyed[d].end() ) total.keyed[d].insert(*h);
+	      else sum->second.Add(h->second);
+	    }
+	}
+    }
+  return total.ok;
+}
+
+void GasTreeAnalysis::Write( TDirectory* dir ) const
+{
+  TDirectory::TContext context( dir );
+  for ( size_t d = 0 ; d < defs.size() ; ++d )
+    {
+      if ( !defs[d].key )
+	{
+	  total.histos[d].Write( defs[d].name );
+	  continue;
+	}
+      std::map<std::string,Histo1D>::const_iterator h = total.keyed[d].begin();
+      for ( ; h != total.keyed[d].end() ; ++h )
+	h->second.Write( defs[d].name + h->first );
+    }
+}
+
+bool GasTreeAnalysis::ProcessEvent( Int_t evid , std::function<void(const GasEvent&)> func ) const
+{
+  for ( size_t f = 0 ; f < files.size() ; ++f )
+    {
+      std::unique_ptr<TFile> file( TFile::Open( files[f].c_str() ) );
+      TTree* tree = file && !file->IsZombie() ? dynamic_cast<TTree*>( file->Get( treeName.c_str() ) ) : 0;
+      if ( !tree || !tree->GetTreeIndex() ) continue;
+      Long64_t entry = tree->GetEntryNumberWithIndex( evid );
+      if ( entry < 0 ) continue;
+      Buffers buffers;
+      GasEvent event;
+      if ( !Attach( tree , buffers , event ) || tree->GetEntry(entry) <= 0 ) return false;
+      func( event );
+      return true;
+    }
+  return false;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file   GasTreeAnalysis.hh
+ *
+ * @brief  Compiled, multi-threaded event loop on the npConv Gas_Tree
+ */
+
+#ifndef GASTREEANALYSIS_HH_
+#define GASTREEANALYSIS_HH_
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "Rtypes.h"
+
+class TDirectory;
+class TTree;
+
+/*!
+ * \brief One primary of an event of the Gas_Tree, as seen by the selections.
+ *
+ * The arrays are ntracks long and are only valid inside the call. They
+ * hold all the tracks of the event: with several primaries per event
+ * (/generator/primariesPerEvent) the selections are called once per
+ * primary, the tracks of the others have prim[i] != primary.
+ */
+struct GasEvent
+{
+  Int_t evid;
+  Int_t ntracks;
+  const Int_t* id;
+  const Int_t* mum;
+  const Int_t* type;
+  const Float_t* edep;
+  const Float_t* zp;
+  const Float_t* t;
+  //! Weight of the track (forced conversion), 1 in files without the w branch
+  const Float_t* w;
+  //! Index of the primary of the track, 0 in files without the prim branch
+  const Int_t* prim;
+  //! Index of the primary being analysed
+  Int_t primary;
+  //! True if track i comes from the primary being analysed
+  bool InPrimary( Int_t i ) const { return prim[i] == primary; }
+  //! Track ID of the primary being analysed (RootSaver: index + 1)
+  Int_t PrimaryTrackID() const { return primary + 1; }
+  //! Sum of edep over the tracks of the primary
+  Double_t SumEdep() const;
+  /*! \brief Weight of the primary, used to fill all the histograms
+   *
+   * Energy-averaged weight of its tracks, as GasHit::GetWeight()
+   * (1 without forced conversion).
+   */
+  Double_t Weight() const;
+  /*! \brief Position of the track in the arrays, -1 if not saved
+   *
+   * Binary search: RootSaver writes the tracks sorted by id.
+   */
+  Int_t FindTrack( Int_t trackID ) const;
+};
+
+/*!
+ * \brief Plain 1D histogram filled by the worker threads.
+ *
+ * No ROOT object is touched inside the event loop: each thread fills
+ * its own Histo1D and the TH1D are created once, after the merge.
+ */
+struct Histo1D
+{
+  Histo1D( Int_t n = 0 , Double_t lo = 0 , Double_t hi = 1 );
+  void Fill( Double_t x , Double_t w = 1 );
+  void Add( const Histo1D& other );
+  //! Write as a TH1D in the current directory
+  void Write( const std::string& name ) const;
+  Int_t nbins;
+  Double_t xlow, xup;
+  //! Underflow, bins, overflow (as TH1)
+  std::vector<Double_t> content, sumw2;
+  Long64_t entries;
+};
+
+/*!
+ * \brief Event loop on the Gas_Tree of one or more files.
+ *
+ * Replaces the TSelector macros (ProcessClassify, sel_baseclass):
+ * the histograms are declared once with AddHisto() / AddClassifier()
+ * and the files are read by SetThreads() worker threads.
+ *
+ * The entries are split in fixed chunks (file, first entry, n entries),
+ * the threads pick the next free chunk and each chunk has its own result.
+ * Chunks are merged in their order and the keys of the classifiers in
+ * alphabetical order, so the output does not depend on the number of
+ * threads nor on their scheduling.
+ *
+ * Each chunk opens its own TFile and enables only the branches used:
+ * ntracks, id, mum, type, edep, zp, t, w, prim and evid. The track arrays
+ * are sized from the largest ntracks stored in the file (no fixed maximum).
+ * Each primary of an entry is a separate fill of every histogram, with
+ * the weight GasEvent::Weight().
+ * Only the default (array) layout of RootSaver is supported, files
+ * written with /saver/splitTrees true have no id branch in Gas_Tree.
+ */
+class GasTreeAnalysis
+{
+public:
+  typedef std::function<bool(const GasEvent&)> Selection;
+  typedef std::function<Double_t(const GasEvent&)> Variable;
+  //! Key of an event for a classifier, empty string: event not used
+  typedef std::function<std::string(const GasEvent&)> Classifier;
+
+  GasTreeAnalysis( const std::string& treeName = "Gas_Tree" );
+
+  void AddFile( const std::string& fileName ) { files.push_back(fileName); }
+  //! Number of worker threads (default: 1)
+  void SetThreads( Int_t n ) { nThreads = n > 0 ? n : 1; }
+  //! Entries per chunk of work
+  void SetChunkSize( Long64_t n ) { chunkSize = n > 0 ? n : 1; }
+
+  //! Histogram of var for the events passing sel (empty sel: all)
+  void AddHisto( const std::string& name , Int_t nbins , Double_t lo , Double_t hi ,
+		 Variable var , Selection sel = Selection() );
+  /*! \brief One histogram of var per key of the event
+   *
+   * The histograms are called prefix+key and created at the first
+   * event with that key, as the processmap of ProcessClassify.
+   */
+  void AddClassifier( const std::string& prefix , Int_t nbins , Double_t lo , Double_t hi ,
+		      Classifier key , Variable var , Selection sel = Selection() );
+
+  //! Run the event loop, false if a file cannot be read
+  bool Run();
+  //! Write all the histograms in dir
+  void Write( TDirectory* dir ) const;
+  Long64_t GetEntries() const { return nEntries; }
+  //! Primaries analysed (more than the entries with several primaries per event)
+  Long64_t GetPrimaries() const { return nPrimaries; }
+
+  /*! \brief Read only the event evid and pass it to func
+   *
+   * Uses the evid index saved by RootSaver, no scan of the files.
+   * False if no file has the event (or the files have no index).
+   */
+  bool ProcessEvent( Int_t evid , std::function<void(const GasEvent&)> func ) const;
+
+private:
+  struct HistoDef {
+    std::string name;
+    Int_t nbins;
+    Double_t lo, hi;
+    Variable var;
+    Selection sel;
+    Classifier key; //!< Empty for a plain histogram
+  };
+  struct Chunk {
+    size_t file;
+    Long64_t first, n;
+  };
+  //! Result of a chunk: plain histograms and keyed histograms of each definition
+  struct Result {
+    std::vector<Histo1D> histos;
+    std::vector< std::map<std::string,Histo1D> > keyed;
+    Long64_t entries, primaries;
+    bool ok;
+  };
+
+  //! Track arrays of one reader, sized for the largest event of the file
+  struct Buffers {
+    std::vector<Int_t> id, mum, type, prim;
+    std::vector<Float_t> edep, zp, t, w;
+  };
+  //! Enable the used branches of tree and point them to buffers and event
+  static bool Attach( TTree* tree , Buffers& buffers , GasEvent& event );
+  //! Split the files in chunks
+  bool MakeChunks( std::vector<Chunk>& chunks ) const;
+  void Process( const Chunk& chunk , Result& result ) const;
+
+  std::string treeName;
+  std::vector<std::string> files;
+  std::vector<HistoDef> defs;
+  Int_t nThreads;
+  Long64_t chunkSize;
+
+  //! Merged result
+  Result total;
+  Long64_t nEntries;
+  Long64_t nPrimaries;
+};
+
+#endif /* GASTREEANALYSIS_HH_ */
@@ -0,0 +1,115 @@
+/**
+ * @file   gasAnalysis.cc
+ *
+ * @brief  Compiled replacement of OldProcCla (ProcessClassify + cm.cxx)
+ *
+ * Usage:
+ *   gasAnalysis [-j threads] [-o output.root] neutr9M_run1.root ...
+ *   gasAnalysis -e evid neutr9M_run1.root ...
+ *
+ * Histograms written in the output file:
+ *  - total: Sum$(edep) of each primary, as the c.Draw() of cm.cxx
+ *  - one histogram per process, named from the particles produced by
+ *    the primary (mum==1) as in ProcessClassify, e.g. p, Ar40, p_C12
+ * Each primary of an event (/generator/primariesPerEvent) is a separate
+ * entry, all the histograms are filled with its weight (w branch, forced
+ * conversion), see GasEvent.
+ *
+ * With -e only the event evid is read, through the evid index, and its
+ * tracks are printed with their chain of mothers.
+ */
+
+#include "GasTreeAnalysis.hh"
+#include "ParticleSpecies.hh"
+#include "TFile.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace {
+  //! Symbol of the particle from the PDG encoding, the number if unknown
+  std::string SpeciesName( Int_t pdg )
+  {
+    const char* name = ParticleSpecies::GetName( pdg );
+    if ( name ) return name;
+    std::ostringstream ss;
+    ss << pdg;
+    return ss.str();
+  }
+
+  //! Particles produced by the primary, joined by '_'
+  std::string ProcessKey( const GasEvent& event )
+  {
+    std::string key;
+    for ( Int_t i = 0 ; i < event.ntracks ; ++i )
+      {
+	if ( event.mum[i] != event.PrimaryTrackID() ) continue;
+	if ( !key.empty() ) key += "_";
+	const char* name = ParticleSpecies::GetName( event.type[i] );
+	if ( name ) key += name;
+	else key += SpeciesName( event.type[i] );
+      }
+    return key;
+  }
+
+  Double_t SumEdep( const GasEvent& event ) { return event.SumEdep(); }
+
+  //! Tracks of the event, each followed by its mothers saved in the gas
+  void PrintAncestry( const GasEvent& event )
+  {
+    std::cout<<"Event "<<event.evid<<": "<<event.ntracks<<" tracks"<<std::endl;
+    for ( Int_t i = 0 ; i < event.ntracks ; ++i )
+      {
+	std::cout<<"  "<<event.id[i]<<" "<<SpeciesName( event.type[i] )
+		 <<" edep="<<event.edep[i]<<" MeV primary="<<event.prim[i]
+		 <<" w="<<event.w[i];
+	for ( Int_t m = event.FindTrack( event.mum[i] ) ; m >= 0 ; m = event.FindTrack( event.mum[m] ) )
+	  std::cout<<" <- "<<event.id[m];
+	std::cout<<" <- "<<event.mum[i]<<std::endl;
+      }
+  }
+}
+
+int main( int argc , char** argv )
+{
+  std::string output = "gasAnalysis.root";
+  Int_t nThreads = std::thread::hardware_concurrency();
+  Int_t evid = -1;
+  GasTreeAnalysis analysis;
+  for ( int i = 1 ; i < argc ; ++i )
+    {
+      if ( !std::strcmp( argv[i] , "-j" ) && i+1 < argc ) nThreads = std::atoi( argv[++i] );
+      else if ( !std::strcmp( argv[i] , "-o" ) && i+1 < argc ) output = argv[++i];
+      else if ( !std::strcmp( argv[i] , "-e" ) && i+1 < argc ) evid = std::atoi( argv[++i] );
+      else analysis.AddFile( argv[i] );
+    }
+  if ( argc < 2 )
+    {
+      std::cerr<<"Usage: "<<argv[0]<<" [-j threads] [-o output.root] [-e evid] files..."<<std::endl;
+      return 1;
+    }
+  if ( evid >= 0 )
+    {
+      if ( analysis.ProcessEvent( evid , PrintAncestry ) ) return 0;
+      std::cerr<<"Event "<<evid<<" not found"<<std::endl;
+      return 1;
+    }
+  analysis.SetThreads( nThreads );
+
+  analysis.AddHisto( "total" , 1000 , 0 , 1000 , SumEdep );
+  analysis.AddClassifier( "" , 2000 , 0 , 2000 , ProcessKey , SumEdep );
+
+  if ( !analysis.Run() )
+    {
+      std::cerr<<"Errors reading the input files"<<std::endl;
+      return 1;
+    }
+  TFile out( output.c_str() , "recreate" );
+  analysis.Write( &out );
+  out.Close();
+  std::cout<<analysis.GetEntries()<<" events ("<<analysis.GetPrimaries()
+	   <<" primaries) analysed, histograms in "<<output<<std::endl;
+  return 0;
+}
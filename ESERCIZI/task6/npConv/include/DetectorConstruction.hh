@@ -41,6 +41,17 @@ public:
 
   //! Update geometry
   void UpdateGeometry();
+
+  /*! \brief Force the neutrons to interact in the PE converter
+   *
+   * A G4BOptrForceCollision is attached to logic_PEConv: each neutron
+   * crossing the converter interacts in it and the interaction products
+   * carry the interaction probability as weight. Needs the neutron
+   * biasing physics (G4GenericBiasingPhysics), to be set before the
+   * geometry is built. \sa npConv.cc
+   */
+  void SetForceConversion( G4bool val ) { forceConversion = val; }
+  G4bool GetForceConversion() const { return forceConversion; }
   
 private:
   //! define needed materials
@@ -113,6 +124,9 @@ private:
 
   //@}
 
+  //! Forced interaction of neutrons in the converter
+  G4bool forceConversion;
+
   //! \name UI Messenger 
   //@{
   DetectorMessenger * messenger;
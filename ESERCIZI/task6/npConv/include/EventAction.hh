@@ -17,10 +17,9 @@
 #include "G4String.hh"
 #include "GasHit.hh"
 #include "SensitiveDetector.hh"
-#include "TrackParticle.hh"
 #include "RootSaver.hh"
-#include "TrackParentParticle.hh"
 #include "G4SystemOfUnits.hh"
+#include <vector>
 
 //ROOT stuff
 
@@ -52,8 +51,6 @@ public:
   void EndOfEventAction(const G4Event* anEvent);
   //! Set the RootSaver
   inline void SetRootSaver( RootSaver* saver ) { rootSaver = saver; }
-  G4double edep;
-  G4int layer;
   
   
   TH1F* hene;
@@ -71,8 +68,10 @@ private:
   //     	    G4String digitsCollName;
   //     	    //! Hits collection ID
   G4int hitsCollID;
-
-  typedef std::map<G4int,TrackParticle*> trackMap_t;
+  //! Per-primary sums of the event, kept to avoid reallocations
+  std::vector<G4double> primaryEdep;
+  std::vector<G4double> primaryWEdep;
+  std::vector<G4double> primaryConverted;
 
 };
 
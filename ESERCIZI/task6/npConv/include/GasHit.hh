@@ -21,6 +21,7 @@
  * It contains
  *  - Hadronic calorimeter layer number
  *  - Deposited energy in layer
+ *  - Weight of the deposited energy (biased simulation)
  */
 class GasHit : public G4VHit {
 public:
@@ -42,9 +43,11 @@ public:
 public:
   //! \name  simple set and get methods
   //@{
-  void          AddEdep(const double e){ eDep += e; }
+  void          AddEdep(const double e, const double w = 1){ eDep += e; wEDep += w*e; }
 
   G4double      GetEdep()        const { return eDep;}
+  //! Energy-averaged weight of the tracks depositing energy (1 if not biased)
+  G4double      GetWeight()      const { return eDep > 0 ? wEDep/eDep : 1; }
   G4int         GetLayerNumber() const { return layerNumber; }
   //@}
 
@@ -55,6 +58,7 @@ public:
 private:
   const G4int   layerNumber;
   G4double      eDep;
+  G4double      wEDep;
 };
 
 // Define the "hit collection" using the template class G4THitsCollection:
@@ -0,0 +1,36 @@
+// $Id:$
+/**
+ * @file
+ * @brief Defines class LeanPhysicsList.
+ */
+
+#ifndef LEANPHYSICSLIST_HH
+#define LEANPHYSICSLIST_HH 1
+
+#include "G4VModularPhysicsList.hh"
+#include "globals.hh"
+
+/*!
+ * \brief Minimal physics for the n-p conversion study
+ *
+ * Only what a few MeV neutron beam on PE and Ar/CO2 needs:
+ *  - all particles and their decays (G4DecayPhysics)
+ *  - standard EM physics for gamma, e+-, protons, alphas and ions,
+ *    including ion ionisation of the recoil nuclei (G4EmStandardPhysics)
+ *  - high precision (G4NDL) neutron elastic, inelastic and capture
+ *    below 20 MeV, neutrons only (\sa NeutronHPPhysics)
+ * No hadronic model is attached to the other particles.
+ * Compare with the reference list: npConv --physics QGSP_BERT_HP
+ */
+class LeanPhysicsList : public G4VModularPhysicsList
+{
+public:
+  //! Constructor
+  LeanPhysicsList();
+  //! Destructor
+  virtual ~LeanPhysicsList();
+  //! Define user cuts
+  virtual void SetCuts();
+};
+
+#endif /* LEANPHYSICSLIST_HH */
@@ -0,0 +1,33 @@
+// $Id:$
+/**
+ * @file
+ * @brief Defines class NeutronHPPhysics.
+ */
+
+#ifndef NEUTRONHPPHYSICS_HH
+#define NEUTRONHPPHYSICS_HH 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "globals.hh"
+
+/*!
+ * \brief High precision neutron physics below 20 MeV
+ *
+ * Elastic, inelastic and capture processes of the neutron with the
+ * G4NDL models and cross sections; no other particle and no model
+ * above 20 MeV. Used by \sa LeanPhysicsList
+ */
+class NeutronHPPhysics : public G4VPhysicsConstructor
+{
+public:
+  //! Constructor
+  NeutronHPPhysics(const G4String& name = "neutronHP");
+  //! Destructor
+  virtual ~NeutronHPPhysics();
+  //! Particles are constructed by the other constructors
+  virtual void ConstructParticle() {}
+  //! Attach the processes to the neutron
+  virtual void ConstructProcess();
+};
+
+#endif /* NEUTRONHPPHYSICS_HH */
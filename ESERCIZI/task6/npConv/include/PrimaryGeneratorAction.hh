@@ -14,6 +14,7 @@
 #include "G4SystemOfUnits.hh"
 
 class G4VPrimaryGenerator;
+class PrimaryGeneratorMessenger;
  
 /*!
 \brief This mandatory user class provides the primary particle generator
@@ -22,6 +23,10 @@ Geant4 provides a number of predefined primary particle generator, to be utilise
  - G4ParticleGun
  - G4GeneralParticleSource
 
+Several independent primaries can be generated in each event
+(/generator/primariesPerEvent): the per-event overhead is shared,
+the tracks are tagged with their primary (\sa TrackingAction).
+
 \sa GeneratePrimaries()
  */
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
@@ -33,11 +38,15 @@ public:
   ~PrimaryGeneratorAction();
   //! defines primary particles (mandatory)
   void GeneratePrimaries(G4Event*);
+  //! number of primaries in each event
+  void SetPrimariesPerEvent(G4int val) { primariesPerEvent = val; }
 private:  
   G4VPrimaryGenerator* InitializeGPS();
 private:
   G4VPrimaryGenerator* gun;
   std::ofstream * outfile;
+  G4int primariesPerEvent;
+  PrimaryGeneratorMessenger* messenger;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
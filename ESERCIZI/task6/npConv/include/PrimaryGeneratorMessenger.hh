@@ -0,0 +1,38 @@
+// $Id:$
+/**
+ * @file
+ * @brief defines class PrimaryGeneratorMessenger
+ */
+
+#ifndef PRIMARYGENERATORMESSENGER_HH
+#define PRIMARYGENERATORMESSENGER_HH 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class PrimaryGeneratorAction;
+class G4UIdirectory;
+class G4UIcmdWithAnInteger;
+
+/*!
+ * \brief This class provides the user interface to PrimaryGeneratorAction
+ *
+ * \sa SetNewValue()
+ */
+class PrimaryGeneratorMessenger : public G4UImessenger
+{
+public:
+  //! Constructor
+  PrimaryGeneratorMessenger(PrimaryGeneratorAction*);
+  //! Destructor
+  virtual ~PrimaryGeneratorMessenger();
+  //! handle user commands
+  void SetNewValue(G4UIcommand*,G4String);
+private:
+  PrimaryGeneratorAction* generator;
+
+  G4UIdirectory*          generatorDir;
+  G4UIcmdWithAnInteger*   primariesCmd;
+};
+
+#endif /* PRIMARYGENERATORMESSENGER_HH */
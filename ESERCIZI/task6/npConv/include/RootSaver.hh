@@ -12,17 +12,18 @@
 #define ROOTSAVER_HH_
 
 #include <string>
+#include <vector>
 #include <TTree.h>
 #include <TFile.h>
 #include "G4UnitsTable.hh"
 #include "GasHit.hh"
-#include "TrackParticle.hh"
+#include "TrackTable.hh"
 #include "SensitiveDetector.hh"
 #include "EventAction.hh"
-#include "TrackParentParticle.hh"
 #include "G4Types.hh"
 
 class TFile;
+class RootSaverMessenger;
 
 /*!
  * \brief Save hits and digits to a ROOT TTree.
@@ -30,6 +31,20 @@ class TFile;
  * This class can be used to save in a TTree hits
  * and digits.
  * The TTree structure is described below.
+ *
+ * By default one TTree entry per event holds all the tracks in arrays
+ * of ntracks elements. The arrays grow with the largest event seen
+ * (doubling their size) and are never shrunk, so no event is dropped.
+ * With /saver/splitTrees true the tracks are instead written one per
+ * entry in a second TTree (Track_Tree), joined to the event tree by evid;
+ * the event tree stores ntracks and the entry of the first track (first).
+ *
+ * Random access: at CloseTree() a TTreeIndex on evid is built and saved
+ * with the event tree, GetEntryWithIndex(evid) reads one event directly.
+ * The tracks of an event are written sorted by id, so a track is found
+ * with a binary search (its mother too, from mum). In both modes first
+ * is the number of tracks written before the event: the entry of the
+ * first track in Track_Tree, or its global position over the arrays.
  */
 class RootSaver
 {
@@ -52,10 +67,6 @@ public:
    * @param fileName : The ROOT file name prefix
    * @param treeName : The name of the TTree
    */
-  typedef std::map<G4int,TrackParticle*> trackMap_t;
-  
-  //typedef std::map<G4int,TrackParentParticle*> trackParentMap_t;
-  
   virtual void CreateTree( const std::string& fileName = "tree" , 
 				 const std::string& treeName = "Gas_Tree" );
   /*! Close the file and save ROOT TTree
@@ -63,15 +74,28 @@ public:
    * \sa CloseTree
    */
   virtual void CloseTree();
-  //! Add hits and digi container for this event
-  virtual void AddEvent(trackMap_t tMap,G4int evID);
+  /*! \brief Add the tracks of this event
+   *
+   * Only the tracks whose mother entered the gas are saved,
+   * the table is read in place (mothers already resolved).
+   */
+  virtual void AddEvent(const TrackTable& tracks,G4int evID);
+  //! Write the tracks in a separate TTree, from the next CreateTree()
+  void SetSplitTrees( G4bool val ) { splitTrees = val; }
 
   
 private:
 
   TFile* rootFile;
   TTree* rootTree; //!< Pointer to the ROOT TTree
+  TTree* trackTree; //!< Pointer to the track TTree (split mode only)
   unsigned int runCounter; //!< Run counter to uniquely identify ROOT file
+  G4bool splitTrees; //!< Tracks in a separate TTree
+  RootSaverMessenger* messenger;
+
+  //! Make the track arrays at least n long, updating the branch addresses
+  void ReserveTracks( Int_t n );
+  Int_t capacity; //!< Size of the track arrays
 
   //! \name TTree variables
   //@{
@@ -100,29 +124,34 @@ private:
   //Start Time
   Float_t* Part_tStart;
   Float_t* MothPart_tStart;
+  //Track weight (forced conversion)
+  Float_t* Part_Weight;
+  //Primary of the track in the event
+  Int_t* Part_Primary;
   
   //Event ID
   Int_t Event_ID;
-
-  
-  
-  
-  
-  
-  //};
-
-
-  //typedef std::map<G4int,TrackParticle*> trackMap_t;
-  
-  typedef std::map<G4int,TrackParentParticle*> trackParentMap_t;
-
-
-//typedef std::map<G4int,TrackParticle*> trackMap_t;
-
-//typedef std::map<G4int,TrackParentParticle*> trackParentMap_t;
-
-  trackParentMap_t GetParentProperties(trackMap_t TParticleMap); 
-
+  //Tracks written before this event (entry in the track TTree in split mode)
+  Long64_t First_Track;
+  //Tracks written so far in this run (array mode)
+  Long64_t Saved_Tracks;
+
+  //One track of the track TTree (split mode)
+  struct TrackRow {
+    Int_t id, mum, type, mtype, prim;
+    Float_t edep, medep, zp, mzp, t, mt, w;
+  };
+  TrackRow trackRow;
+  //@}
+
+  //! Rows of the table written for this event, sorted by track ID
+  std::vector<G4int> savedRows;
+  //! Order rows of the track table by track ID
+  struct ByTrackID {
+    ByTrackID( const TrackTable& t ) : tracks(t) {}
+    bool operator()( G4int a , G4int b ) const { return tracks.GetID(a) < tracks.GetID(b); }
+    const TrackTable& tracks;
+  };
 };
 
 #endif /* ROOTSAVER_HH_ */
@@ -0,0 +1,38 @@
+// $Id:$
+/**
+ * @file
+ * @brief defines class RootSaverMessenger
+ */
+
+#ifndef ROOTSAVERMESSENGER_HH
+#define ROOTSAVERMESSENGER_HH 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class RootSaver;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+
+/*!
+ * \brief This class provides the user interface to RootSaver
+ *
+ * \sa SetNewValue()
+ */
+class RootSaverMessenger : public G4UImessenger
+{
+public:
+  //! Constructor
+  RootSaverMessenger(RootSaver*);
+  //! Destructor
+  virtual ~RootSaverMessenger();
+  //! handle user commands
+  void SetNewValue(G4UIcommand*,G4String);
+private:
+  RootSaver*        saver;
+
+  G4UIdirectory*    saverDir;
+  G4UIcmdWithABool* splitCmd;
+};
+
+#endif /* ROOTSAVERMESSENGER_HH */
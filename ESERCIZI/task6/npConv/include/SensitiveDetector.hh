@@ -17,8 +17,7 @@
 
 //our homemade class
 
-#include "TrackParticle.hh" 
-#include "TrackParentParticle.hh"
+#include "TrackTable.hh"
 
 class DetectorConstruction;
 class RunAction;
@@ -69,19 +68,13 @@ private:
   
   GasHitCollection* hitCollection;          //< Collection of hits in the gas
 
-  typedef std::map<G4int,TrackParticle*> trackMap_t;
-  trackMap_t trackMap;
-
-  typedef std::map<G4int,TrackParentParticle*> trackParentMap_t;
-  trackParentMap_t trackParentMap;
-
-
-
-  //map getter
+  //Tracks entering the gas in this event
+  TrackTable trackTable;
 
 public:
   
-trackMap_t GetTrackMap() {return trackMap;}
+  //Table of this event, the mothers are resolved in EndOfEvent
+  const TrackTable& GetTrackTable() const {return trackTable;}
 
 };
   #endif
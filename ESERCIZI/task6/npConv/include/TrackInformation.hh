@@ -0,0 +1,47 @@
+///Index of the primary particle a track descends from
+//
+//With several primaries per event (/generator/primariesPerEvent)
+//each track carries the index of its primary (0,1,...,N-1 in the
+//order of generation), so the analysis can split the event back
+//into the N independent primaries. Set by TrackingAction.
+
+#ifndef TRACKINFORMATION_HH_
+#define TRACKINFORMATION_HH_
+
+#include "globals.hh"
+#include "G4Allocator.hh"
+#include "G4VUserTrackInformation.hh"
+
+class TrackInformation : public G4VUserTrackInformation
+{
+
+public:
+
+  TrackInformation(G4int primary) : primaryIndex(primary) {}
+  virtual ~TrackInformation() {}
+
+  inline void *operator new(size_t);
+  inline void operator delete(void *aTrackInfo);
+
+  G4int GetPrimaryIndex() const { return primaryIndex; }
+  void Print() const { G4cout << "Primary index " << primaryIndex << G4endl; }
+
+private:
+
+  G4int primaryIndex;
+
+};
+
+extern G4Allocator<TrackInformation> TrackInformationAllocator;
+
+inline void* TrackInformation::operator new(size_t)
+{
+  return (void *) TrackInformationAllocator.MallocSingle();
+}
+
+inline void TrackInformation::operator delete(void *aTrackInfo)
+{
+  TrackInformationAllocator.FreeSingle((TrackInformation*) aTrackInfo);
+}
+
+#endif
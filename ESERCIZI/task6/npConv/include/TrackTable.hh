@@ -0,0 +1,73 @@
+///Per-event table of the tracks entering the gas
+//
+//One row for each track, in the order the tracks enter the gas, with one
+//array (column) for each property: the same layout as the TTree branches,
+//so RootSaver copies the columns without any lookup.
+//The SensitiveDetector fills the table during the event and resolves
+//the mother of each track at the end of the event; the table is passed
+//by reference and the memory of the columns is kept from event to event.
+
+#ifndef TRACKTABLE_HH_
+#define TRACKTABLE_HH_
+
+#include "globals.hh"
+#include <vector>
+
+class TrackTable
+{
+
+public:
+
+  TrackTable();
+  ~TrackTable();
+
+  //Empty the table for a new event (memory is kept)
+  void Clear();
+
+  //Row of this track, -1 if the track has not entered the gas yet
+  G4int FindRow(G4int trackID) const
+  {
+    return ( trackID >= 0 && trackID < static_cast<G4int>(rowOfTrack.size()) ) ? rowOfTrack[trackID] : -1;
+  }
+  //New row for a track at its first step in the gas, returns the row
+  G4int AddTrack(G4int trackID, G4int mumID, G4int ptype, G4double z, G4double t, G4double w = 1, G4int primary = 0);
+  void AddEdep(G4int row, G4double val) { edep[row] += val; }
+
+  //Set the mother row of each track, -1 if the mother has not entered the gas
+  void ResolveParents();
+
+  //Number of rows
+  G4int GetSize() const { return id.size(); }
+
+  //Columns, one entry per row
+  G4int GetID(G4int row) const { return id[row]; }
+  G4int GetMumID(G4int row) const { return mum[row]; }
+  G4int GetType(G4int row) const { return type[row]; }
+  G4double GetEdep(G4int row) const { return edep[row]; }
+  G4double GetZStart(G4int row) const { return zStart[row]; }
+  G4double GetTStart(G4int row) const { return tStart[row]; }
+  //Track weight at the first step in the gas (1 if not biased)
+  G4double GetWeight(G4int row) const { return weight[row]; }
+  //Index of the primary of the track in the event
+  G4int GetPrimary(G4int row) const { return primary[row]; }
+  //Valid after ResolveParents()
+  G4int GetMumRow(G4int row) const { return mumRow[row]; }
+
+private:
+
+  std::vector<G4int> id;
+  std::vector<G4int> mum;
+  std::vector<G4int> type;
+  std::vector<G4double> edep;
+  std::vector<G4double> zStart;
+  std::vector<G4double> tStart;
+  std::vector<G4double> weight;
+  std::vector<G4int> primary;
+  std::vector<G4int> mumRow;
+
+  //Row of each track, indexed by track ID (IDs in one event are 1,2,3...)
+  std::vector<G4int> rowOfTrack;
+
+};
+
+#endif
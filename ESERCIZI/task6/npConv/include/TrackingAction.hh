@@ -0,0 +1,31 @@
+/**
+ * @file   TrackingAction.hh
+ *
+ * @brief  User's TrackingAction.
+ */
+
+#ifndef TRACKINGACTION_HH_
+#define TRACKINGACTION_HH_
+
+#include "G4UserTrackingAction.hh"
+
+/*!
+ * \brief User's TrackingAction class
+ * Tags each track with the index of its primary particle
+ * (\sa TrackInformation): primaries get their own index,
+ * secondaries inherit the one of their mother.
+ */
+class TrackingAction : public G4UserTrackingAction
+{
+public:
+  //! constructor
+  TrackingAction() {}
+  //! destructor
+  virtual ~TrackingAction() {}
+  //! Tag the primaries
+  void PreUserTrackingAction(const G4Track* aTrack);
+  //! Pass the tag to the secondaries
+  void PostUserTrackingAction(const G4Track* aTrack);
+};
+
+#endif /* TRACKINGACTION_HH_ */
@@ -28,7 +28,10 @@
 #include "G4HadronPhysicsQGSP_BERT_HP.hh"
 #include "EventAction.hh"
 #include "RunAction.hh"
+#include "TrackingAction.hh"
 #include "QGSP_BIC_HP.hh" /////Physics Lits for low energy neutrons
+#include "G4GenericBiasingPhysics.hh"
+#include "LeanPhysicsList.hh"
 
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -42,6 +45,32 @@
 */
 int main(int argc,char** argv)
 {
+  //Options: npConv [macro] [--force-conversion] [--physics lean|QGSP_BERT_HP]
+  //--force-conversion forces the neutron interactions in the PE converter
+  //(biased simulation, the tracks carry a weight)
+  //--physics selects the physics list, QGSP_BERT_HP by default
+  G4String macroFile = "";
+  G4bool forceConversion = false;
+  G4String physicsName = "QGSP_BERT_HP";
+  for ( G4int i = 1 ; i < argc ; ++i )
+    {
+      G4String arg = argv[i];
+      if ( arg == "--force-conversion" ) forceConversion = true;
+      else if ( arg == "--physics" )
+	{
+	  //A missing value must not be taken as the macro
+	  if ( i+1 >= argc )
+	    {
+	      G4cerr << "--physics needs a value" << G4endl
+		     << "Usage: " << argv[0]
+		     << " [macro] [--force-conversion] [--physics lean|QGSP_BERT_HP]" << G4endl;
+	      return 1;
+	    }
+	  physicsName = argv[++i];
+	}
+      else macroFile = arg;
+    }
+
   //choose the Random engine
   //using the same as TRandom3 di root
   // it has a period of 2^19937-1
@@ -51,7 +80,8 @@ int main(int argc,char** argv)
   G4RunManager * runManager = new G4RunManager();
 
   // mandatory Initialization classes 
-  G4VUserDetectorConstruction* detector = new DetectorConstruction();
+  DetectorConstruction* detector = new DetectorConstruction();
+  detector->SetForceConversion(forceConversion);
   runManager->SetUserInitialization(detector);
 
   // Local user Physics List
@@ -60,14 +90,33 @@ int main(int argc,char** argv)
   // Reference Physics List from Geant4 kernel 
   //G4VUserPhysicsList* physics = new QGSP_BERT();
 
-  G4cout << "Setting Physics List" << G4endl;
-  G4VUserPhysicsList* physics = new QGSP_BERT_HP();  //Declare a physics list using QGSP_BERT_HP 
-                                                   //HP is for low energy neutrons and uses G4NDL cross sections
+  G4cout << "Setting Physics List: " << physicsName << G4endl;
+  G4VModularPhysicsList* physics = 0;
+  if ( physicsName == "lean" )
+    {
+      //Only neutron HP, EM and decays (see LeanPhysicsList)
+      physics = new LeanPhysicsList();
+    }
+  else
+    {
+      if ( physicsName != "QGSP_BERT_HP" )
+	G4cerr << "Unknown physics list " << physicsName << ", using QGSP_BERT_HP" << G4endl;
+      physics = new QGSP_BERT_HP();  //Declare a physics list using QGSP_BERT_HP 
+                                     //HP is for low energy neutrons and uses G4NDL cross sections
+    }
 
   //G4VUserPhysicsList* physics = new QGSP_BIC_HP();  //Declare a physics list using QGSP_BERT_HP 
 
   //G4VUserPhysicsList* physics = new CopperPhysicsList();
 
+  //Neutron processes are wrapped for the biasing of DetectorConstruction
+  if ( forceConversion )
+    {
+      G4GenericBiasingPhysics* biasingPhysics = new G4GenericBiasingPhysics();
+      biasingPhysics->Bias("neutron");
+      physics->RegisterPhysics(biasingPhysics);
+    }
+
   // mandatory User class  
   runManager->SetUserInitialization(physics);
    
@@ -82,6 +131,7 @@ int main(int argc,char** argv)
   RunAction* run_action = new RunAction(event_action);
   runManager->SetUserAction( event_action );
   runManager->SetUserAction( run_action );
+  runManager->SetUserAction( new TrackingAction );
 
   // Initialize G4 kernel
   runManager->Initialize();
@@ -94,11 +144,10 @@ int main(int argc,char** argv)
   //
   G4UImanager * UImanager = G4UImanager::GetUIpointer();  
 
-  if (argc!=1) {  // batch mode  
+  if (macroFile != "") {  // batch mode  
     
       G4String command = "/control/execute ";
-      G4String fileName = argv[1];
-      UImanager->ApplyCommand(command+fileName);
+      UImanager->ApplyCommand(command+macroFile);
   }
   else {           // interactive mode : define UI session
      
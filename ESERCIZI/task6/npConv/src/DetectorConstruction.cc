@@ -23,12 +23,15 @@
 #include "SensitiveDetector.hh"
 #include "G4SDManager.hh"
 
+#include "G4BOptrForceCollision.hh"
+
 DetectorConstruction::DetectorConstruction()
   : vacuum(0) 
   , Ar_Mat(0)
   , PE_Mat(0)
   , logicWorld(0)
   , halfWorldLength(0.5*km)
+  , forceConversion(false)
 {
   //Create a messanger (defines custom UI commands)
   messenger = new DetectorMessenger(this);
@@ -241,6 +244,17 @@ G4VPhysicalVolume* DetectorConstruction::Construct_PEConv_ArDet()
       
       logicPEConv -> SetVisAttributes(new G4VisAttributes(green));
 
+      //Forced n-p conversion: the neutron is split in a part that
+      //interacts in the converter and a part that crosses it freely,
+      //with weights given by the interaction probability
+      if ( forceConversion )
+	{
+	  G4cout << "Neutron interactions are forced in logic_PEConv" << G4endl;
+	  G4BOptrForceCollision* forceOperator =
+	    new G4BOptrForceCollision("neutron","forceConversion");
+	  forceOperator->AttachTo(logicPEConv);
+	}
+
       //**************************************************************//
 
       //*****************Construct Argon Detector************************//
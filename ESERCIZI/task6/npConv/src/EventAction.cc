@@ -17,7 +17,11 @@
 #include "G4SDManager.hh"
 #include "G4DigiManager.hh"
 #include "G4Event.hh"
+#include "ProgressReporter.hh"
 #include "SensitiveDetector.hh"
+#include "RunController.hh"
+#include "G4PrimaryVertex.hh"
+#include <algorithm>
 
 EventAction::EventAction()
   : hene(0)
@@ -26,6 +30,8 @@ EventAction::EventAction()
   , hitsCollID(-1)
 
 {
+  //conversion efficiency can be used to stop the run (/precision/)
+  RunController::GetInstance()->RegisterObservable("conversion");
 }
 
 EventAction::~EventAction()
@@ -46,13 +52,8 @@ SensitiveDetector* EventAction::GetSensitiveDetector(G4String detname)
   return sens;
 }
 
-void EventAction::BeginOfEventAction(const G4Event* anEvent )
+void EventAction::BeginOfEventAction(const G4Event* /*anEvent*/ )
 {
-  if ( anEvent->GetEventID() % 10 == 0 ) //1000
-    {
-      G4cout<<"Starting Event: "<<anEvent->GetEventID()<<G4endl;
-    }
-  
   //Retrieve the ID for the hit collection
   if ( hitsCollID == -1 )
     {
@@ -64,6 +65,7 @@ void EventAction::BeginOfEventAction(const G4Event* anEvent )
 
 void EventAction::EndOfEventAction(const G4Event* anEvent)
 {
+  ProgressReporter::GetInstance()->EndOfEvent();
 
   //G4cout << "End of One EVENT !!!!!!!!!!!!!!!!!!!" << G4endl;
 
@@ -73,70 +75,71 @@ void EventAction::EndOfEventAction(const G4Event* anEvent)
   //         //Store information
   //if ( rootSaver )
   //     {
-  //Retrieve hits collections
-  G4HCofThisEvent* hitsCollections = anEvent->GetHCofThisEvent();
-  GasHitCollection* hits = 0;
-  if ( hitsCollections )
+  //*************************************************************//
+  //Retrieve the map corrisponfing to SensitiveDetector with sdname
+
+  G4String sdname = "/myDet/ArCO2";
+  SensitiveDetector* sensitive = this->GetSensitiveDetector(sdname);
+
+  //The table is read in place, no copy
+  const TrackTable& tracks = sensitive->GetTrackTable();
+
+  //Number of primaries in this event (/generator/primariesPerEvent):
+  //each of them is an independent neutron and is analysed on its own
+  G4int nPrimaries = 0;
+  for ( G4int v = 0 ; v < anEvent->GetNumberOfPrimaryVertex() ; ++v )
+    nPrimaries += anEvent->GetPrimaryVertex(v)->GetNumberOfParticle();
+
+  //Energy (and energy-weighted weight) in the gas of each primary
+  primaryEdep.assign(nPrimaries,0);
+  primaryWEdep.assign(nPrimaries,0);
+  for ( G4int row = 0 ; row < tracks.GetSize() ; ++row )
     {
-      hits = static_cast<GasHitCollection*>( hitsCollections->GetHC(hitsCollID) );
+      G4int prim = tracks.GetPrimary(row);
+      if ( prim >= nPrimaries ) continue;
+      primaryEdep[prim] += tracks.GetEdep(row);
+      primaryWEdep[prim] += tracks.GetWeight(row)*tracks.GetEdep(row);
     }
-  //******WE DO NOT NEED THIS**********************//
-  //Get Postion and Momentum of primary
-  //This is needed to store in ntuple info @ z=0
-  //const G4ThreeVector& pos = anEvent->GetPrimaryVertex()->GetPosition();
-  //const G4ThreeVector& mom = anEvent->GetPrimaryVertex()->GetPrimary()->GetMomentum();
-  //***********************************************//
-  
-  if ( hits ) //hits container found we can proceed
+
+  //G4cout << "Filling histogram >>>>>>>>>>>>>>>>>>>>" << G4endl;
+  //G4cout << "Edep = " << edep << G4endl;
+  //One entry per primary, also with a single primary per event:
+  //the histogram does not depend on /generator/primariesPerEvent
+  int check = 0;
+  if (hene)
     {
-      //Loop on all hits
-      //Now we loop on hits and add the energy to our arrays,
-      //basically we are transforming the hit container in a plain array
-      typedef std::vector<GasHit*>::const_iterator hitsVector_it;
-      hitsVector_it hit = hits->GetVector()->begin();
-      hitsVector_it end = hits->GetVector()->end();
-      for ( ; hit != end ; ++hit)
+      for ( G4int prim = 0 ; prim < nPrimaries ; ++prim )
 	{
-	  layer = (*hit)->GetLayerNumber();
-	  edep = (*hit)->GetEdep();
+	  G4double w = primaryEdep[prim] > 0 ? primaryWEdep[prim]/primaryEdep[prim] : 1;
+	  check = hene->Fill(primaryEdep[prim]/keV,w);
 	}
     }
-  //G4cout << "Filling histogram >>>>>>>>>>>>>>>>>>>>" << G4endl;
-  //G4cout << "Edep = " << edep << G4endl;
-  int check = 0;
-  if (hene) check = hene->Fill(edep/keV);
   
   //G4cout << "Address of hene: " << static_cast<void*>(hene) << " Check: " 
   //	 << check <<  G4endl;
-  
-  //*************************************************************//
-  //Retrieve the map corrisponfing to SensitiveDetector with sdname
-
-  G4String sdname = "/myDet/ArCO2";
-  SensitiveDetector* sensitive = this->GetSensitiveDetector(sdname);
 
-  trackMap_t trackMap = sensitive->GetTrackMap();
-  
-  //Define iterators
-  trackMap_t::iterator itt = trackMap.begin();
-  trackMap_t::iterator itt_end = trackMap.end();
-  
-  // for ( ; itt != itt_end ; ++itt)
-//     {
-//       G4cout << "\n" ;
-
-//       G4cout << "!!!!!!!!!!!!!!!!EVENT ACTION " 
-// 	     << "Energy Deposited by particle ID "
-// 	     << itt->first 
-// 	     << " that is a " << (itt->second)->GetPart_name() << "  is  " 
-// 	     << G4BestUnit( (itt->second)->GetTot_Edep(),"Energy") 
-// 	     << G4endl;
-      
-//     }
-
-  
+  //Conversion: a proton depositing energy in the gas,
+  //counted with its weight when the conversion is forced.
+  //One value for each primary, in the same event
+  RunController* controller = RunController::GetInstance();
+  if ( controller->IsActive() )
+    {
+      primaryConverted.assign(std::max(nPrimaries,1),0);
+      for ( G4int row = 0 ; row < tracks.GetSize() ; ++row )
+	{
+	  G4int prim = tracks.GetPrimary(row);
+	  if ( prim < static_cast<G4int>(primaryConverted.size()) &&
+	       tracks.GetType(row) == 2212 && tracks.GetEdep(row) > 0 &&
+	       primaryConverted[prim] == 0 )
+	    {
+	      primaryConverted[prim] = tracks.GetWeight(row);
+	    }
+	}
+      //All the primaries at once: the controller counts events
+      controller->AddValues(&primaryConverted[0],primaryConverted.size());
+    }
   
-  rootSaver->AddEvent(trackMap, anEvent->GetEventID());
+  rootSaver->AddEvent(tracks, anEvent->GetEventID());
 
 }
 
@@ -12,7 +12,8 @@ G4Allocator<GasHit> GasHitAllocator;
 
 GasHit::GasHit(const G4int layer) :
 		layerNumber(layer),
-		eDep(0)
+		eDep(0),
+		wEDep(0)
 		
 {
   
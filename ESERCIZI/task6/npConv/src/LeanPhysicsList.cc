@@ -0,0 +1,31 @@
+// $Id:$
+/**
+ * @file
+ * @brief Implements class LeanPhysicsList.
+ */
+
+#include "LeanPhysicsList.hh"
+#include "NeutronHPPhysics.hh"
+
+#include "G4DecayPhysics.hh"
+#include "G4EmStandardPhysics.hh"
+#include "G4SystemOfUnits.hh"
+
+LeanPhysicsList::LeanPhysicsList() : G4VModularPhysicsList()
+{
+  //Same default cut as the reference lists
+  defaultCutValue = 0.7*mm;
+  SetVerboseLevel(1);
+
+  RegisterPhysics( new G4DecayPhysics() );
+  RegisterPhysics( new G4EmStandardPhysics() );
+  RegisterPhysics( new NeutronHPPhysics() );
+}
+
+LeanPhysicsList::~LeanPhysicsList()
+{}
+
+void LeanPhysicsList::SetCuts()
+{
+  SetCutsWithDefault();
+}
@@ -0,0 +1,59 @@
+// $Id:$
+/**
+ * @file
+ * @brief Implements class NeutronHPPhysics.
+ */
+
+#include "NeutronHPPhysics.hh"
+
+#include "G4Neutron.hh"
+#include "G4ProcessManager.hh"
+#include "G4SystemOfUnits.hh"
+
+#include "G4HadronElasticProcess.hh"
+#include "G4NeutronHPElastic.hh"
+#include "G4NeutronHPElasticData.hh"
+
+#include "G4NeutronInelasticProcess.hh"
+#include "G4NeutronHPInelastic.hh"
+#include "G4NeutronHPInelasticData.hh"
+
+#include "G4HadronCaptureProcess.hh"
+#include "G4NeutronHPCapture.hh"
+#include "G4NeutronHPCaptureData.hh"
+
+NeutronHPPhysics::NeutronHPPhysics(const G4String& name)
+  : G4VPhysicsConstructor(name)
+{}
+
+NeutronHPPhysics::~NeutronHPPhysics()
+{}
+
+void NeutronHPPhysics::ConstructProcess()
+{
+  G4ProcessManager* pManager = G4Neutron::Neutron()->GetProcessManager();
+
+  //Elastic: n-p scattering is the conversion
+  G4HadronElasticProcess* elastic = new G4HadronElasticProcess();
+  G4NeutronHPElastic* elasticModel = new G4NeutronHPElastic();
+  elasticModel->SetMaxEnergy(20*MeV);
+  elastic->RegisterMe(elasticModel);
+  elastic->AddDataSet(new G4NeutronHPElasticData());
+  pManager->AddDiscreteProcess(elastic);
+
+  //Inelastic
+  G4NeutronInelasticProcess* inelastic = new G4NeutronInelasticProcess();
+  G4NeutronHPInelastic* inelasticModel = new G4NeutronHPInelastic();
+  inelasticModel->SetMaxEnergy(20*MeV);
+  inelastic->RegisterMe(inelasticModel);
+  inelastic->AddDataSet(new G4NeutronHPInelasticData());
+  pManager->AddDiscreteProcess(inelastic);
+
+  //Capture
+  G4HadronCaptureProcess* capture = new G4HadronCaptureProcess();
+  G4NeutronHPCapture* captureModel = new G4NeutronHPCapture();
+  captureModel->SetMaxEnergy(20*MeV);
+  capture->RegisterMe(captureModel);
+  capture->AddDataSet(new G4NeutronHPCaptureData());
+  pManager->AddDiscreteProcess(capture);
+}
@@ -5,7 +5,7 @@
  */
 
 #include "PrimaryGeneratorAction.hh"
-#include "PrimaryGeneratorAction.hh"
+#include "PrimaryGeneratorMessenger.hh"
 
 #include "G4Event.hh"
 #include "G4ParticleGun.hh"
@@ -16,18 +16,22 @@
 
 PrimaryGeneratorAction::PrimaryGeneratorAction()
   : outfile(0)
+  , primariesPerEvent(1)
 {
   gun = InitializeGPS();
-  
+  messenger = new PrimaryGeneratorMessenger(this);
 }
 
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 { 
-  gun->GeneratePrimaryVertex(anEvent);
+  //Each call adds an independent vertex
+  for ( G4int i = 0 ; i < primariesPerEvent ; ++i )
+    gun->GeneratePrimaryVertex(anEvent);
 }
 
 PrimaryGeneratorAction::~PrimaryGeneratorAction()
 {
+  delete messenger;
   delete gun;
 }
 
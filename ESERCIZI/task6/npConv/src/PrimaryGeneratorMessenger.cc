@@ -0,0 +1,36 @@
+// $Id:$
+/**
+ * @file
+ * @brief Implements class PrimaryGeneratorMessenger
+ */
+
+#include "PrimaryGeneratorMessenger.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAnInteger.hh"
+
+PrimaryGeneratorMessenger::PrimaryGeneratorMessenger(PrimaryGeneratorAction* gen) :
+  generator(gen)
+{
+  generatorDir = new G4UIdirectory("/generator/");
+  generatorDir->SetGuidance("primary generation");
+
+  primariesCmd = new G4UIcmdWithAnInteger("/generator/primariesPerEvent",this);
+  primariesCmd->SetGuidance("Number of independent primaries (from /gps/) in each event.");
+  primariesCmd->SetGuidance("The tracks are tagged with the index of their primary.");
+  primariesCmd->SetParameterName("primaries",false);
+  primariesCmd->SetRange("primaries>0");
+  primariesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+PrimaryGeneratorMessenger::~PrimaryGeneratorMessenger()
+{
+  delete primariesCmd;
+  delete generatorDir;
+}
+
+void PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* cmd,G4String newValue)
+{
+  if ( cmd == primariesCmd )
+    generator->SetPrimariesPerEvent( primariesCmd->GetNewIntValue(newValue) );
+}
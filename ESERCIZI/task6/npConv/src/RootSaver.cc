@@ -9,6 +9,7 @@
  */
 
 #include "RootSaver.hh"
+#include "RootSaverMessenger.hh"
 #include "GasHit.hh"
 #include "TTree.h"
 #include "TFile.h"
@@ -16,29 +17,35 @@
 #include <sstream>
 #include <iostream>
 #include <cassert>
+#include <algorithm>
 #include "G4Types.hh"
-#include "TrackParentParticle.hh"
 #include "G4UnitsTable.hh"
 
 RootSaver::RootSaver() :
 	rootFile(0),
 	rootTree(0),
+	trackTree(0),
 	runCounter(0),
-	Tot_Tracks(0)
+	splitTrees(false),
+	capacity(0),
+	Tot_Tracks(0),
+	PartID(0),
+	Part_Moth_ID(0),
+	PartType(0),
+	MothPartType(0),
+	Part_EnDep(0),
+	MothPart_EnDep(0),
+	Part_zStart(0),
+	MothPart_zStart(0),
+	Part_tStart(0),
+	MothPart_tStart(0),
+	Part_Weight(0),
+	Part_Primary(0),
+	First_Track(0),
+	Saved_Tracks(0)
 {
-
-  PartID = new Int_t[10000];
-  Part_Moth_ID = new Int_t[10000];
-  PartType = new Int_t[10000];
-  MothPartType = new Int_t[10000];
-  Part_EnDep = new Float_t[10000];
-  MothPart_EnDep = new Float_t[10000];
-  Part_zStart = new Float_t[10000];
-  MothPart_zStart = new Float_t[10000];
-  Part_tStart = new Float_t[10000];
-  MothPart_tStart = new Float_t[10000];
-  
-
+  messenger = new RootSaverMessenger(this);
+  ReserveTracks(1024);
 }
 
 RootSaver::~RootSaver()
@@ -48,6 +55,55 @@ RootSaver::~RootSaver()
 	{
 		CloseTree();
 	}
+	delete messenger;
+	delete[] PartID;
+	delete[] Part_Moth_ID;
+	delete[] PartType;
+	delete[] MothPartType;
+	delete[] Part_EnDep;
+	delete[] MothPart_EnDep;
+	delete[] Part_zStart;
+	delete[] MothPart_zStart;
+	delete[] Part_tStart;
+	delete[] MothPart_tStart;
+	delete[] Part_Weight;
+	delete[] Part_Primary;
+}
+
+void RootSaver::ReserveTracks( Int_t n )
+{
+  if ( n <= capacity ) return;
+  //Geometric growth: few reallocations whatever the largest event
+  capacity = std::max( n , 2*capacity );
+  //The content is refilled at each event, nothing to copy
+  delete[] PartID;          PartID = new Int_t[capacity];
+  delete[] Part_Moth_ID;    Part_Moth_ID = new Int_t[capacity];
+  delete[] PartType;        PartType = new Int_t[capacity];
+  delete[] MothPartType;    MothPartType = new Int_t[capacity];
+  delete[] Part_EnDep;      Part_EnDep = new Float_t[capacity];
+  delete[] MothPart_EnDep;  MothPart_EnDep = new Float_t[capacity];
+  delete[] Part_zStart;     Part_zStart = new Float_t[capacity];
+  delete[] MothPart_zStart; MothPart_zStart = new Float_t[capacity];
+  delete[] Part_tStart;     Part_tStart = new Float_t[capacity];
+  delete[] MothPart_tStart; MothPart_tStart = new Float_t[capacity];
+  delete[] Part_Weight;     Part_Weight = new Float_t[capacity];
+  delete[] Part_Primary;    Part_Primary = new Int_t[capacity];
+
+  if ( rootTree && !trackTree )
+    {
+      rootTree->SetBranchAddress( "id", PartID );
+      rootTree->SetBranchAddress( "mum", Part_Moth_ID );
+      rootTree->SetBranchAddress( "type", PartType );
+      rootTree->SetBranchAddress( "mtype", MothPartType );
+      rootTree->SetBranchAddress( "edep", Part_EnDep );
+      rootTree->SetBranchAddress( "medep", MothPart_EnDep );
+      rootTree->SetBranchAddress( "zp", Part_zStart );
+      rootTree->SetBranchAddress( "mzp", MothPart_zStart );
+      rootTree->SetBranchAddress( "t", Part_tStart );
+      rootTree->SetBranchAddress( "mt", MothPart_tStart );
+      rootTree->SetBranchAddress( "w", Part_Weight );
+      rootTree->SetBranchAddress( "prim", Part_Primary );
+    }
 }
 
 void RootSaver::CreateTree( const std::string& fileName , 
@@ -76,6 +132,31 @@ void RootSaver::CreateTree( const std::string& fileName ,
 	
 	rootTree = new TTree( treeName.data() , treeName.data() );
 	
+	if ( splitTrees )
+	  {
+	    //Event TTree: number of tracks and first entry in the track TTree
+	    rootTree->Branch( "ntracks" , &Tot_Tracks, "ntracks/I" );
+	    rootTree->Branch( "first" , &First_Track, "first/L" );
+	    rootTree->Branch( "evid", &Event_ID, "evid/I" );
+
+	    //Track TTree: one entry per track
+	    trackTree = new TTree( "Track_Tree" , "Track_Tree" );
+	    trackTree->Branch( "evid", &Event_ID, "evid/I" );
+	    trackTree->Branch( "id", &trackRow.id , "id/I" );
+	    trackTree->Branch( "mum", &trackRow.mum , "mum/I" );
+	    trackTree->Branch( "type", &trackRow.type , "type/I" );
+	    trackTree->Branch( "mtype", &trackRow.mtype , "mtype/I" );
+	    trackTree->Branch( "edep", &trackRow.edep , "edep/F" );
+	    trackTree->Branch( "medep", &trackRow.medep , "medep/F" );
+	    trackTree->Branch( "zp", &trackRow.zp , "zp/F" );
+	    trackTree->Branch( "mzp", &trackRow.mzp , "mzp/F" );
+	    trackTree->Branch( "t", &trackRow.t , "t/F" );
+	    trackTree->Branch( "mt", &trackRow.mt , "mt/F" );
+	    trackTree->Branch( "w", &trackRow.w , "w/F" );
+	    trackTree->Branch( "prim", &trackRow.prim , "prim/I" );
+	    return;
+	  }
+
 	//Define Branches for the tree
 	rootTree->Branch( "ntracks" , &Tot_Tracks, "ntracks/I2" );
 	rootTree->Branch( "id", PartID , "id[ntracks]/I2");
@@ -88,7 +169,12 @@ void RootSaver::CreateTree( const std::string& fileName ,
 	rootTree->Branch( "mzp", MothPart_zStart  , "mzp[ntracks]/F");
 	rootTree->Branch( "t", Part_tStart  , "t[ntracks]/F");
 	rootTree->Branch( "mt", MothPart_tStart  , "mt[ntracks]/F");
+	rootTree->Branch( "w", Part_Weight  , "w[ntracks]/F");
+	rootTree->Branch( "prim", Part_Primary  , "prim[ntracks]/I");
 	rootTree->Branch("evid",&Event_ID,"evid/I2");
+	//Tracks written before this event: global offset of its first track
+	rootTree->Branch( "first" , &First_Track, "first/L" );
+	Saved_Tracks = 0;
 }
 
 void RootSaver::CloseTree()
@@ -106,7 +192,12 @@ void RootSaver::CloseTree()
       rootTree->Print();
       
       rootFile->ReOpen("Update");
+
+      //Sorted index on the event ID, saved with the TTree:
+      //GetEntryWithIndex(evid) finds an event without a scan
+      if ( rootTree->GetEntries() > 0 ) rootTree->BuildIndex( "evid" );
     
+      if (trackTree) trackTree->Write();
       if (rootTree->Write() !=0)
 	{
 	  G4cout << "TTree correctly written in the file" << G4endl;
@@ -127,18 +218,12 @@ void RootSaver::CloseTree()
       rootFile->Close();
       //The root is automatically deleted.
       rootTree = 0;
-      
-      delete[] PartID;
-      delete[] PartType;
-      delete[] Part_EnDep;
-      delete[] Part_Moth_ID;
-      delete[] Part_zStart;
-      delete[] Part_tStart;
-      
+      trackTree = 0;
+      //The track arrays are kept for the next run
     }
 }
 
-void RootSaver::AddEvent(trackMap_t trackMap, G4int evID )
+void RootSaver::AddEvent(const TrackTable& tracks, G4int evID )
 {
   //If root TTree is not created ends
   if ( rootTree == 0 )
@@ -151,290 +236,77 @@ void RootSaver::AddEvent(trackMap_t trackMap, G4int evID )
   //G4cout << ">>>>>>>>>>>>>>>Adding Event Number: " << Event_ID 
   //	 << "<<<<<<<<<<<<<<<" << G4endl;
 
-  trackParentMap_t trackParentMap = this->GetParentProperties(trackMap);
-  
-  Tot_Tracks = trackParentMap.size();
+  //Tracks with the mother in the gas are saved
+  Tot_Tracks = 0;
+  for ( G4int row = 0 ; row < tracks.GetSize() ; ++row )
+    {
+      if ( tracks.GetMumRow(row) >= 0 ) ++Tot_Tracks;
+    }
 
   //G4cout << "Total Tracks= " << Tot_Tracks << G4endl;
   
-  trackParentMap_t::iterator itt = trackParentMap.begin();
-  trackParentMap_t::iterator itt_end = trackParentMap.end();
-  Int_t i=0;
-  
-  
-  if(Tot_Tracks < 10000) 
-    {
-      for ( ; itt != itt_end ; ++itt)
-	{
-
-	//G4cout << "\n" ;
-
- 	/// G4cout << "!!!!!!!!!!!!!!!!ROOT SAVER " 
- 	/// 	 << "Energy Deposited by particle ID "
- 	/// 	 << itt->first 
- 	/// 	 << " that is a " << (itt->second)->GetPart_name() << "  is  " 
- 	/// 	 << G4BestUnit( (itt->second)->GetTot_Edep(),"Energy") 
- 	/// 	 << G4endl;
-	  
-	  
+  //Nothing to save: the event is not written, as before
+  if (Tot_Tracks == 0) return;
 
-	  PartID[i] = itt->first;
-	  Part_Moth_ID[i] = ( itt->second ) ->GetMoth_Part_ID() ;
-	  PartType[i] = (itt->second)->GetPart_Type();
-	  MothPartType[i] = (itt->second)->GetMothPart_Type();
-	  //G4cout << "PartType[" << i << "] = " << PartType[i] << G4endl;
-	  Part_EnDep[i] = static_cast<Double_t>( ( (itt->second)->GetTot_Edep() )/ MeV ) ;
-	  MothPart_EnDep[i] =  static_cast<Double_t>( (itt->second)->GetMothTot_Edep()  / MeV );
-	  Part_zStart[i] =   ( (itt->second )  ->GetZStart_Pos() / mm ); 
-	  MothPart_zStart[i] = ( (itt->second)->GetMothZStart_Pos()  / mm ) ;
-	  Part_tStart[i] = ( (itt->second)->GetStart_Time() ) / ns;
-	  MothPart_tStart[i] = (itt->second)->GetMothStart_Time() / ns;
-	  
-	  // G4cout << "PartID[" << i << "] = " << PartID[i] 
-// 		 << "  Energy Deposition = " << Part_EnDep[i] << G4endl ;
-
-	  //DO NOT SAVE PRIMARY PARTICLES THAT HAVE NOT DEPOSITED ANY ENERGY!!!!
-	  //if (Part_EnDep[i] > 0 || PartID[i] > 1)   i++;
-	  i++;
-	}
-      
-      //SINCE WE DECIDED TO NOT SAVE PRIMARY PARTICLES THAT DO NOT
-      //DEPOSIT ANY ENERGY, WE HAVE TO CORRECT THE NUMBER OF
-      //*RECORDED* TRACKS
-      Tot_Tracks = i;
-      
-      // G4cout << "Total Tracks: " << i << G4endl;
-      
-      if (Tot_Tracks > 0) rootTree->Fill();
-    }
-  else
+  //Tracks are written sorted by ID, a track is found in the event
+  //with a binary search on id (see RootSaver class description)
+  savedRows.clear();
+  for ( G4int row = 0 ; row < tracks.GetSize() ; ++row )
     {
-      G4cout << "Number of tracks (" << Tot_Tracks << ") exceed maximum limit in event " 
-	     << Event_ID << " ---> Event not saved in the Tree" << G4endl;
+      if ( tracks.GetMumRow(row) >= 0 ) savedRows.push_back(row);
     }
-  
-}
-
-typedef std::map<G4int,TrackParentParticle*> trackParentMap_t;
-
-trackParentMap_t RootSaver::GetParentProperties(trackMap_t TParticleMap)
-{
-  //DEFINE ENTRIES TO BE STORED IN EACH TRACKPARENTPARTICLE OBJECT
-  
-  G4int trackID=0;
-  
-  G4int MothtrackID=0;
-  
-  G4int ptype=0;
-
-  G4double edep=0;
-
-  G4double zp=0;
-  
-  G4double zs=0;
+  std::sort( savedRows.begin() , savedRows.end() , ByTrackID(tracks) );
 
-  G4String pname = "";
-
-  G4int pptype=0;
-   
-  G4double pedep=0;
-
-  G4double pzp=0;
-  
-  G4double pzs=0;
-
-  G4String ppname = "";
-
-  G4int IntArray[3] = {0,0,0};
-
-  G4double DoubleArray[6] = {0,0,0,0,0,};
-
-  //DEFINE ITERATOR TO THE TRACKPARTICLEMAP PASSED IN THE FUNCTION
-  
-  trackMap_t::iterator it = TParticleMap.begin();
-  
-  //DEFINE AN OBJECT OF THE CLASS TRACKPARENTMAP FOR SUCCESSIVE STORING
-
-  trackParentMap_t TParentMap;
-
-  //Clear the map
-  TParentMap.clear();
-  
-  //Define iterator pointing at the first element of the trackParentMap_t Map
-  trackParentMap_t::iterator parit = TParentMap.begin();
-  
-  
-  for (; it!=TParticleMap.end(); it++)
+  if ( trackTree )
     {
-      TrackParentParticle* track_parent_par = new TrackParentParticle();
-      
-      trackID = it->first;
-      MothtrackID = static_cast<G4int>( ( static_cast<TrackParticle*> (it->second) ) ->GetMoth_Part_ID() );
-      
-      IntArray[0] = MothtrackID;
-      
-      //G4cout << "<<<<<<<<< TrackID: " << trackID << "   MotherTrackID: " 
-      //       <<  MothtrackID << " >>>>>>>>>>>> " << G4endl;  
-      
-      //Try to find the element in TParticleMap with trackID==MothertrackID in order to get the parent
-      //properties
-      trackMap_t::iterator it_tmp = TParticleMap.find(MothtrackID);
-      
-      //Look if the element with trackID is already present in the TParentMap
-      //=> It should not be the case since TParentMap is fresh
-      trackParentMap_t::iterator it_tmp_par = TParentMap.find(trackID); 	  
-      
-      if(it_tmp != TParticleMap.end() )  
-  	{
-	  
-	  //it is used to get the present particle properties while it_tmp is used to get the 
-	  //mother particle properties once identified the mother particle
-	  
-  	  //track_parent_par = (it_tmp_par->second);
-  	    
-  	  //MothtrackID = ( static_cast<TrackParticle*> (it->second) ) ->GetMoth_Part_ID();
-  	  
-  	  ptype = ( static_cast<TrackParticle*> (it->second) ) ->GetPart_Type();
-	  
-	  IntArray[1] = ptype;
-	  
-	  pptype = ( static_cast<TrackParticle*> (it_tmp->second) ) ->GetPart_Type();
-	  
-	  IntArray[2] = pptype;
-	  
-	  edep   = ( static_cast<TrackParticle*> (it->second) ) ->GetTot_Edep();
-	  
-	  DoubleArray[0] = edep;
-	  
-	  pedep   = ( static_cast<TrackParticle*> (it_tmp->second) ) ->GetTot_Edep();
-	  
-	  DoubleArray[1] = pedep;
-	  
-	  pname   = ( static_cast<TrackParticle*> (it->second) ) ->GetPart_name();
-	  
-	  ppname   = ( static_cast<TrackParticle*> (it_tmp->second) ) ->GetPart_name();
-	  
-	  zp = ( static_cast<TrackParticle*> (it->second) ) ->GetZStart_Pos();
-	  
-	  DoubleArray[2] = zp;
-	  
-	  pzp = ( static_cast<TrackParticle*> (it_tmp->second) ) ->GetZStart_Pos();
-	  
-	  DoubleArray[3] = pzp;
-	  
-  	  zs = ( static_cast<TrackParticle*> (it->second) ) ->GetStart_Time();
-	  
-  	  DoubleArray[4] = zs;
-	  
-  	  pzs = ( static_cast<TrackParticle*> (it_tmp->second) ) ->GetStart_Time();
-	  
-  	  DoubleArray[5] = pzs;
-	  
-	  bool printvalues = false;
-
-	  if(printvalues)
-	    {
-
-	      G4cout << "***********PRESENT PARTICLE*********** \n" << G4endl;
-	      G4cout << "Track ID: "  << trackID 
-		     << "\t Type: "   << ptype 
-		     << "\t Name: "   << pname 
-		     << "\t EDep: "   << G4BestUnit(edep,"Energy")  
-		     << "\t ZStPos: " << G4BestUnit(zp,"Length")    
-		     << "\t TStart: " << G4BestUnit(zs, "Time")    
-		     << "\n" << G4endl;
-	      
-	      G4cout << "***********MOTHER PARTICLE*********** \n" << G4endl;
-	      G4cout << "Mother Track ID: "  << MothtrackID  
-		     << "\t Mother Type: "   << pptype 
-		     << "\t Mother Name: "   << ppname 
-		     << "\t Mother EDep: "   << G4BestUnit(pedep,"Energy")  
-		     << "\t Mother ZStPos: " << G4BestUnit(pzp,"Length")    
-		
-		     << "\t Mother TStart: " << G4BestUnit(pzs, "Time")
-		     << "\n" << G4endl;
-	      
-	      G4cout << " \n" << G4endl;
-	    }
-	  
-	  //Set the properties into the temporary TrackParentParticleObject declared at the 
-	  //beginning of the for cycle
-	  track_parent_par->SetIntValues(IntArray);
-  	  track_parent_par->SetDoubleValues(DoubleArray);
-      
-	  
-	  //After setting the int and double values into the TrackParentParticleObject
-	  //it is stored in TParentMap
-	  if (printvalues) G4cout << "Inserting entry with key/trackID " << trackID 
-				  << " in the map" << G4endl;
-	  
-	  TParentMap.insert( std::make_pair(trackID, track_parent_par) );
-	     
-	  ///**************OLD**************************************************  
-  	  /// //SET ONCE AGAIN PRESENT PARTICLE PROPERTIES
-  	  //track_parent_par->SetPart_Type(ptype);  //OK
-  	  //track_parent_par->SetMothPart_ID(MothtrackID); //NO 
-  	  //track_parent_par->DoubleSet_Type_MumID(ptype,MothtrackID); //NO
-      
-  	  //track_parent_par->SetEdep(edep); //OK
-  	  //track_parent_par->SetPart_name(pname); //NO
-  	  //track_parent_par->SetZStart_Pos(zp); //OK
-  	  //track_parent_par->SetStart_Time(zs); //OK
-  	  
-  	  //SET PARENT PARTICLE PROPERTIES
-  	  
-  	  //track_parent_par->SetMoth_Part_Type(pptype); //OK
-  	  //track_parent_par->SetMoth_Edep(pedep);
-  	  //track_parent_par->SetMoth_Part_name(ppname);
-  	  //track_parent_par->SetMoth_ZStart_Pos(pzp); 
-  	  //track_parent_par->SetMoth_Start_Time(pzs);
-	  //*********************************************************************
-	} 
-      
-      else
+      //Split mode: one entry of the track TTree per track
+      First_Track = trackTree->GetEntries();
+      for ( size_t i = 0 ; i < savedRows.size() ; ++i )
 	{
-	  bool noentry = false;
-	  if(noentry) G4cout << "No Entry in the map with the key/trackID " 
-			     << MothtrackID << G4endl;
+	  G4int row = savedRows[i];
+	  G4int mrow = tracks.GetMumRow(row);
+	  trackRow.id = tracks.GetID(row);
+	  trackRow.mum = tracks.GetMumID(row);
+	  trackRow.type = tracks.GetType(row);
+	  trackRow.mtype = tracks.GetType(mrow);
+	  trackRow.edep = tracks.GetEdep(row) / MeV;
+	  trackRow.medep = tracks.GetEdep(mrow) / MeV;
+	  trackRow.zp = tracks.GetZStart(row) / mm;
+	  trackRow.mzp = tracks.GetZStart(mrow) / mm;
+	  trackRow.t = tracks.GetTStart(row) / ns;
+	  trackRow.mt = tracks.GetTStart(mrow) / ns;
+	  trackRow.w = tracks.GetWeight(row);
+	  trackRow.prim = tracks.GetPrimary(row);
+	  trackTree->Fill();
 	}
-	  
-      bool printvalues_end = false;
-      
-      if(printvalues_end) G4cout << "Size of the map is " << TParentMap.size() << G4endl;
-
-      //We do not need to delete this object
-      //if(track_parent_par) delete track_parent_par;
-
+      rootTree->Fill();
+      return;
     }
 
-  bool printmap = false;
+  //The arrays grow with the largest event, no event is dropped
+  ReserveTracks(Tot_Tracks);
 
-  if(printmap)
+  First_Track = Saved_Tracks;
+  Saved_Tracks += Tot_Tracks;
+  for ( Int_t i = 0 ; i < Tot_Tracks ; ++i )
     {
-      G4cout << "Print TParentMap values before returing it \n" << G4endl;
-
-      trackParentMap_t::iterator pmit = TParentMap.begin();
-      trackParentMap_t::iterator pmit_end = TParentMap.end();
-      
-
-      for( ; pmit!=pmit_end; ++pmit)
-	
-	{
-	  G4int tid = pmit->first;
-	  G4double  ed = ( static_cast<TrackParentParticle*> (pmit->second) ) ->GetTot_Edep();
-	  G4double ped = ( static_cast<TrackParentParticle*> (pmit->second) ) ->GetMothTot_Edep();
-	    
-
-
-	  G4cout << "Track ID= " << tid
-		 << "\n Particle-Edep= " << G4BestUnit(ed,"Energy")
-		 << "\n Mother Particle-Edep= " << G4BestUnit(ped,"Energy") 
-		 << "\n" << G4endl;
-	}
+      G4int row = savedRows[i];
+      G4int mrow = tracks.GetMumRow(row);
+
+      PartID[i] = tracks.GetID(row);
+      Part_Moth_ID[i] = tracks.GetMumID(row);
+      PartType[i] = tracks.GetType(row);
+      MothPartType[i] = tracks.GetType(mrow);
+      //G4cout << "PartType[" << i << "] = " << PartType[i] << G4endl;
+      Part_EnDep[i] = tracks.GetEdep(row) / MeV;
+      MothPart_EnDep[i] = tracks.GetEdep(mrow) / MeV;
+      Part_zStart[i] = tracks.GetZStart(row) / mm;
+      MothPart_zStart[i] = tracks.GetZStart(mrow) / mm;
+      Part_tStart[i] = tracks.GetTStart(row) / ns;
+      MothPart_tStart[i] = tracks.GetTStart(mrow) / ns;
+      Part_Weight[i] = tracks.GetWeight(row);
+      Part_Primary[i] = tracks.GetPrimary(row);
     }
 
-  return TParentMap;
-  
+  rootTree->Fill();
 }
-  	  
-  	
@@ -0,0 +1,36 @@
+// $Id:$
+/**
+ * @file
+ * @brief Implements class RootSaverMessenger
+ */
+
+#include "RootSaverMessenger.hh"
+#include "RootSaver.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+
+RootSaverMessenger::RootSaverMessenger(RootSaver* rs) :
+  saver(rs)
+{
+  saverDir = new G4UIdirectory("/saver/");
+  saverDir->SetGuidance("ROOT TTree output");
+
+  splitCmd = new G4UIcmdWithABool("/saver/splitTrees",this);
+  splitCmd->SetGuidance("Write the tracks in a separate TTree (Track_Tree), one entry per track,");
+  splitCmd->SetGuidance("joined to the event TTree by evid. Applied from the next run.");
+  splitCmd->SetParameterName("split",true);
+  splitCmd->SetDefaultValue(true);
+  splitCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+RootSaverMessenger::~RootSaverMessenger()
+{
+  delete splitCmd;
+  delete saverDir;
+}
+
+void RootSaverMessenger::SetNewValue(G4UIcommand* cmd,G4String newValue)
+{
+  if ( cmd == splitCmd )
+    saver->SetSplitTrees( splitCmd->GetNewBoolValue(newValue) );
+}
@@ -11,21 +11,27 @@
 #include "RunAction.hh"
 #include "EventAction.hh"
 #include "G4Run.hh"
+#include "ProgressReporter.hh"
+#include "RunController.hh"
 
 
 RunAction::RunAction(EventAction* theEventAction ) 
   : eventAction(theEventAction)
 {
+  //Create the reporter now so that its UI commands are available
+  ProgressReporter::GetInstance();
   eventAction->SetRootSaver( &saver );
 }
 
 void RunAction::BeginOfRunAction(const G4Run* aRun )
 {
+	ProgressReporter::GetInstance()->BeginOfRun(aRun->GetNumberOfEventToBeProcessed());
 	G4cout<<"Starting Run: "<<aRun->GetRunID()<<G4endl;
 //        //For each run a new TTree is created, with default names
         
 	G4cout << "!!!!!!!!!!!!!!!Creating ROOT TTree!!!!!!!!!!!!!" << G4endl;
 	saver.CreateTree();
+	RunController::GetInstance()->PrepareNewRun();
 
 	out_root_f = new TFile("histoEnergy.root","RECREATE");
 	hrun = new TH1F("EnDis","Energy Distribution",1000,0,1000);
@@ -41,8 +47,10 @@ void RunAction::BeginOfRunAction(const G4Run* aRun )
 
 void RunAction::EndOfRunAction( const G4Run* aRun )
 {
+	ProgressReporter::GetInstance()->EndOfRun();
 	G4cout<<"Ending Run: "<<aRun->GetRunID()<<G4endl;
 	G4cout<<"Number of events: "<<aRun->GetNumberOfEvent()<<G4endl;
+	RunController::GetInstance()->EndOfRun();
 	
 	// G4cout << "Address of hrun in RunAction: " 
 // 	       << static_cast<void*>(hrun) << G4endl;
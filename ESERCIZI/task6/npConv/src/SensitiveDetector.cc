@@ -20,8 +20,7 @@
 
 #include "G4TouchableHistory.hh"
 
-#include "TrackParticle.hh" 
-#include "TrackParentParticle.hh"
+#include "TrackInformation.hh"
 
 //#include "TrackingAction.hh"
 //#include "TrackInformation.hh"
@@ -72,96 +71,28 @@ G4bool SensitiveDetector::ProcessHits(G4Step *step, G4TouchableHistory *)
   G4int copyNo = touchable->GetVolume(0)->GetCopyNo();
   G4int HDGeindex = copyNo; //It is defined as 1
  
-  TrackParticle *Tparticle = new TrackParticle();
-
-
   G4Track* thistrack   = step->GetTrack();
-  
-  
-  
-  /////TrackInformation* info = (TrackInformation*)( thistrack->GetUserInformation() );
-  /////
-  /////G4cout << "<<<<<<<<<<<<<<<<<<<<<<TRACKINFORMATION DECLARED>>>>>>>>>>>>>>>>>>>>>>" << G4endl;
-  /////
-  /////G4double parentPos = (info->GetOriginalPosition()).getZ();
-  /////
-  /////G4cout << "<<<<<<<<<<<<<<<<<<<<<<AFTER GETORIGINALZPOSITION>>>>>>>>>>>>>>>>>>>>>>" << G4endl;
-
-
-  G4double trackenergy = thistrack->GetDynamicParticle()->GetKineticEnergy();
 
-    //Define the key for the trackMap_t
+  //Define the key for the trackMap_t
   G4int    thistrackID = thistrack->GetTrackID();
-  
-  G4String trackname   = thistrack->GetDefinition()->GetParticleName();
-  
-  G4int    parentID    = thistrack->GetParentID();
-  
-  //G4cout << " Track " << thistrackID << " Total Energy  = " 
-  //  << G4BestUnit(trackenergy,"Energy") << " Type " << trackname << " Mum " 
-  //  << parentID << G4endl;
-  
-  //G4cout << "\n" << G4endl;
-
-  G4int trackPDGencod = thistrack->GetDefinition()->GetPDGEncoding();
-
-  G4double zstartpos = ( thistrack->GetVertexPosition() ).getZ();
-
-  G4double starttime = thistrack->GetGlobalTime();
-
-  //G4cout << "This track time is: " << G4BestUnit(starttime,"Time") << G4endl;
-  
-  //G4ThreeVector stoppos = step->GetPostStepPoint()->GetPosition();
-
-
-  //****************************************************************************//
-  //Filling the members of TrackParticle   
-  
-  //Mother Track ID
-  Tparticle->SetMothPart_ID(parentID);
 
   // energy deposit in this step 
   G4double edep = step->GetTotalEnergyDeposit();
 
   //G4cout << " Total Step Energy Deposit Edep = " << G4BestUnit(edep,"Energy") << G4endl;
-  
-  //Total EnergyDeposited
-  //Tparticle->TrackAddEDep(edep);
-  
-  //Particle Type via PDG_Encoding
-
-  Tparticle->SetPart_Type(trackPDGencod);
-  
-  //Set Particle Name (string)
-  
-  Tparticle->SetPart_name(trackname);
-
-  //Set Particle Start Position
-
-  Tparticle->SetZStart_Pos(zstartpos);
-
-  Tparticle->SetStart_Time(starttime);
-  
-  //
-  //Set Particle Stop Position (not used)
-  //
-  //Tparticle->SetStop_Pos(stoppos);
-  //
 
   if( (edep)/MeV > 2)
     {
       G4cout << "1 -- ERROR IN EDEP: In the Iterator Edep " << 
       	G4BestUnit(edep,"Energy") << 
-      	" from particle: name " << trackname << " ID " << thistrackID 
-      	     << " with mum " << parentID << " produced at " 
-	     << G4BestUnit(zstartpos,"Length")<< G4endl;
+      	" from particle: name " << thistrack->GetDefinition()->GetParticleName()
+	     << " ID " << thistrackID 
+      	     << " with mum " << thistrack->GetParentID() << " produced at " 
+	     << G4BestUnit(thistrack->GetVertexPosition().getZ(),"Length")<< G4endl;
       
       G4cout << "\n";
     }
 
-
-  
-
   //**************************************************************************//  
 
 
@@ -208,64 +139,55 @@ G4bool SensitiveDetector::ProcessHits(G4Step *step, G4TouchableHistory *)
       hitCollection->insert(aHit);
     }
   
-  aHit->AddEdep( edep ); //This method is defined in GasHit.hh
+  aHit->AddEdep( edep, thistrack->GetWeight() ); //This method is defined in GasHit.hh
   
   //******************************************************************************//
 
 
-  //This is the part where the TrackMap is filled//
+  //This is the part where the TrackTable is filled//
 
 
-  //Look if an entry of the Track Map is already filled
-  trackMap_t::iterator itt = trackMap.find(thistrackID);
-  
+  //Look if a row of the Track Table is already filled
+  G4int row = trackTable.FindRow(thistrackID);
   
+  if ( row < 0 )
+    {
+      //Track from this particle does not exist
+      //we create it: this is the first step of the track in the gas.
+      //Mother track ID, type via PDG encoding, start position,
+      //time of the first step in the gas, weight (biasing) and primary
+      TrackInformation* info = static_cast<TrackInformation*>(thistrack->GetUserInformation());
+      row = trackTable.AddTrack(thistrackID,
+				thistrack->GetParentID(),
+				thistrack->GetDefinition()->GetPDGEncoding(),
+				( thistrack->GetVertexPosition() ).getZ(),
+				thistrack->GetGlobalTime(),
+				thistrack->GetWeight(),
+				info ? info->GetPrimaryIndex() : 0);
+      if (HDGeindex==1) trackTable.AddEdep(row,edep);
+    }
   
-  if ( itt != trackMap.end() )
+  else
     {
       //track for this ID already exists
       //we update it
-      //remember the hit pointer
       if(HDGeindex ==1)
 	{
-	  Tparticle = itt->second;
-
-	  //G4cout << "Prompt2 Edep = " << G4BestUnit(edep,"Energy") << G4endl;
-
-	  (itt->second)->TrackAddEDep(edep);
+	  trackTable.AddEdep(row,edep);
 	}
-      //  G4cout << "In the Iterator Edep " << 
-      //G4BestUnit((itt->second)->GetTot_Edep(),"Energy") << 
-      //" from particle " << (itt->second)->GetPart_Type() << G4endl;
 
-      if( ( (itt->second) -> GetTot_Edep() )/MeV > 2 )
+      if( ( trackTable.GetEdep(row) )/MeV > 2 )
 	{
 	  G4cout << "2 -- ERROR IN EDEP: In the Iterator Edep " << 
-	    G4BestUnit((itt->second)->GetTot_Edep(),"Energy") << 
-	    " from particle " << (itt->second)->GetPart_Type() << 
-	    " name " << (itt->second)->GetPart_name() << " with mum " 
-	  	 << (itt->second)->GetMoth_Part_ID() << " with ID " << thistrackID 
-		 << " produced at " << G4BestUnit(zstartpos,"Length") << G4endl;
+	    G4BestUnit(trackTable.GetEdep(row),"Energy") << 
+	    " from particle " << trackTable.GetType(row) << 
+	    " name " << thistrack->GetDefinition()->GetParticleName() << " with mum " 
+	  	 << trackTable.GetMumID(row) << " with ID " << thistrackID 
+		 << " produced at " << G4BestUnit(trackTable.GetZStart(row),"Length") << G4endl;
 	  
 	  G4cout << "\n";
         }
     }
-  
-  else
-    {
-      //Track from this particle does not exist
-      //we create it
-      if (HDGeindex==1) 
-	{
-	  Tparticle->SetEdep(edep);
-	}
-      else 
-	{
-	  Tparticle->SetEdep(0);
-	}
-      trackMap.insert(std::make_pair(thistrackID,Tparticle) );
-      
-    }
 
   
   
@@ -295,11 +217,14 @@ void SensitiveDetector::Initialize(G4HCofThisEvent* HCE)
   
   
   hitMap.clear();
-  trackMap.clear();
+  trackTable.Clear();
 }
 
 void SensitiveDetector::EndOfEvent(G4HCofThisEvent*)
 {
+  //All the tracks are known: find the row of each mother
+  trackTable.ResolveParents();
+
 	/*
   // test output of hits
   G4cout << "EndOfEvent method of SD `" << GetName() << "' called." << G4endl;
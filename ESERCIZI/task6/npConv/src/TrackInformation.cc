@@ -0,0 +1,5 @@
+///Index of the primary particle a track descends from
+
+#include "TrackInformation.hh"
+
+G4Allocator<TrackInformation> TrackInformationAllocator;
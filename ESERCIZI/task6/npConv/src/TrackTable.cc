@@ -0,0 +1,60 @@
+///Per-event table of the tracks entering the gas
+
+#include "TrackTable.hh"
+#include <algorithm>
+
+TrackTable::TrackTable()
+{
+  id.reserve(1024);
+  mum.reserve(1024);
+  type.reserve(1024);
+  edep.reserve(1024);
+  zStart.reserve(1024);
+  tStart.reserve(1024);
+  weight.reserve(1024);
+  primary.reserve(1024);
+  mumRow.reserve(1024);
+}
+
+TrackTable::~TrackTable()
+{}
+
+void TrackTable::Clear()
+{
+  //Only the entries used in this event are reset
+  for ( size_t row = 0 ; row < id.size() ; ++row ) rowOfTrack[id[row]] = -1;
+  id.clear();
+  mum.clear();
+  type.clear();
+  edep.clear();
+  zStart.clear();
+  tStart.clear();
+  weight.clear();
+  primary.clear();
+  mumRow.clear();
+}
+
+G4int TrackTable::AddTrack(G4int trackID, G4int mumID, G4int ptype, G4double z, G4double t, G4double w, G4int prim)
+{
+  if ( trackID >= static_cast<G4int>(rowOfTrack.size()) )
+    {
+      rowOfTrack.resize( std::max( static_cast<size_t>(trackID+1) , 2*rowOfTrack.size() ) , -1 );
+    }
+  G4int row = id.size();
+  rowOfTrack[trackID] = row;
+  id.push_back(trackID);
+  mum.push_back(mumID);
+  type.push_back(ptype);
+  edep.push_back(0);
+  zStart.push_back(z);
+  tStart.push_back(t);
+  weight.push_back(w);
+  primary.push_back(prim);
+  return row;
+}
+
+void TrackTable::ResolveParents()
+{
+  mumRow.resize(id.size());
+  for ( size_t row = 0 ; row < id.size() ; ++row ) mumRow[row] = FindRow(mum[row]);
+}
@@ -0,0 +1,31 @@
+/**
+ * @file   TrackingAction.cc
+ *
+ * @brief  Implements user class TrackingAction.
+ */
+
+#include "TrackingAction.hh"
+#include "TrackInformation.hh"
+
+#include "G4TrackingManager.hh"
+#include "G4Track.hh"
+
+void TrackingAction::PreUserTrackingAction(const G4Track* aTrack)
+{
+  //Primaries are numbered 1..N in the order they were generated
+  if ( aTrack->GetParentID() == 0 && aTrack->GetUserInformation() == 0 )
+    {
+      const_cast<G4Track*>(aTrack)->SetUserInformation( new TrackInformation(aTrack->GetTrackID()-1) );
+    }
+}
+
+void TrackingAction::PostUserTrackingAction(const G4Track* aTrack)
+{
+  TrackInformation* info = static_cast<TrackInformation*>(aTrack->GetUserInformation());
+  G4TrackVector* secondaries = fpTrackingManager->GimmeSecondaries();
+  if ( info == 0 || secondaries == 0 ) return;
+  for ( size_t i = 0 ; i < secondaries->size() ; ++i )
+    {
+      (*secondaries)[i]->SetUserInformation( new TrackInformation(info->GetPrimaryIndex()) );
+    }
+}
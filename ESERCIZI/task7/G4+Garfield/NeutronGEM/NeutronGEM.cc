@@ -28,25 +28,32 @@
 /// \file mainNeutronGEM.cc
 /// \brief Main program of the NeutronGEM
 
+#ifdef G4MULTITHREADED
+#include "G4MTRunManager.hh"
+#include "G4Threading.hh"
+#else
 #include "G4RunManager.hh"
+#endif
 #include "G4ScoringManager.hh"
 #include "G4UImanager.hh"
 #include "Randomize.hh"
 
 #include "NeutronGEMDetectorConstruction.hh"
 #include "NeutronGEMPhysicsList.hh"
-#include "NeutronGEMPrimaryGeneratorAction.hh"
-#include "NeutronGEMRunAction.hh"
-#include "NeutronGEMEventAction.hh"
-#include "NeutronGEMStackingAction.hh"
-#include "NeutronGEMSteppingAction.hh"
-#include "NeutronGEMTrackingAction.hh"
+#include "NeutronGEMActionInitialization.hh"
 #include "NeutronGEMDataManager.hh"
 #include "NeutronGEMHistoManager.hh"
 
 #include "GarfieldG4FastSimulationModel.hh"
 #include "GarfieldPhysics.hh"
 
+#include "RVersion.h"
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+#include "TROOT.h"
+#else
+#include "TThread.h"
+#endif
+
 #ifdef G4VIS_USE
 #include "G4VisExecutive.hh"
 #endif
@@ -69,7 +76,25 @@ int main(int argc, char** argv) {
 
 	// Construct the default run manager
 	//
+#ifdef G4MULTITHREADED
+	// Number of threads: NEUTRONGEM_THREADS, default all the cores.
+	// Heed is not thread safe: the threads take turns in the drift gap
+	// unless the cluster library is used (/garfield/useClusterLibrary)
+	G4int nThreads = G4Threading::G4GetNumberOfCores();
+	if (getenv("NEUTRONGEM_THREADS")) {
+		nThreads = atoi(getenv("NEUTRONGEM_THREADS"));
+	}
+	G4MTRunManager * runManager = new G4MTRunManager;
+	runManager->SetNumberOfThreads(nThreads);
+	// The threads create their own ROOT files and geometries
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+	ROOT::EnableThreadSafety();
+#else
+	TThread::Initialize();
+#endif
+#else
 	G4RunManager * runManager = new G4RunManager;
+#endif
 	NeutronGEMDataManager* dataManager = NeutronGEMDataManager::GetInstance();
 
 	if (argc != 1)   // batch mode
@@ -97,34 +122,32 @@ int main(int argc, char** argv) {
 	NeutronGEMHistoManager* histoManager = new NeutronGEMHistoManager();
 	dataManager->setHistoManager(histoManager);
 
+	// The gas and the physics list are made by runManager->Initialize() below,
+	// before any macro: their settings come from the environment
+	// (NEUTRONGEM_GAS_CACHE, NEUTRONGEM_ION_MOBILITY and
+	// NEUTRONGEM_GARFIELD_PARTICLES, e.g. "e-:0:10000,gamma:0:10000,alpha:0:2000";
+	// "none": no Garfield model), the /garfield/ commands are too late for them
 	GarfieldPhysics* garfieldPhysics = new GarfieldPhysics("GdAndB4C");
-	//garfieldPhysics->AddParticleName("alpha", 0.0, 2000.0);
-	//garfieldPhysics->AddParticleName("Li7", 0.0, 2000.0);
-	//garfieldPhysics->AddParticleName("e-", 0.0, 10000.0);
-	//garfieldPhysics->AddParticleName("gamma", 0.0, 10000.0);
+	if (!garfieldPhysics->AddParticleNames(
+			GarfieldPhysics::DefaultParticleNames())) {
+		G4cerr << "Bad NEUTRONGEM_GARFIELD_PARTICLES" << G4endl;
+		delete garfieldPhysics;
+		delete runManager;
+		return 1;
+	}
 
 	runManager->SetUserInitialization(
 			new NeutronGEMPhysicsList(garfieldPhysics));
 
+	// The model of each thread is created by ConstructSDandField(),
+	// the worker threads use clones of garfieldPhysics
 	NeutronGEMDetectorConstruction* detectorConstruction =
-			new NeutronGEMDetectorConstruction();
+			new NeutronGEMDetectorConstruction(garfieldPhysics);
 	runManager->SetUserInitialization(detectorConstruction);
 
 	// Set user action classes
 	//
-	runManager->SetUserAction(new NeutronGEMPrimaryGeneratorAction());
-
-	NeutronGEMRunAction* runAction = new NeutronGEMRunAction();
-	//
-	runManager->SetUserAction(runAction);
-	//
-	runManager->SetUserAction(new NeutronGEMEventAction);
-	//
-	runManager->SetUserAction(new NeutronGEMStackingAction);
-
-	runManager->SetUserAction(new NeutronGEMSteppingAction);
-
-	runManager->SetUserAction(new NeutronGEMTrackingAction);
+	runManager->SetUserInitialization(new NeutronGEMActionInitialization);
 	//theApp.Run(kTRUE);
 	// Initialize G4 kernel
 	//
@@ -132,7 +155,6 @@ int main(int argc, char** argv) {
 
 	GarfieldG4FastSimulationModel* garfieldG4FastSimulationModel =
 			detectorConstruction->GetGarfieldG4FastSimulationModel();
-	garfieldG4FastSimulationModel->SetPhysics(garfieldPhysics);
 #ifdef G4VIS_USE
 
 	// Initialise visualisation
@@ -174,7 +196,12 @@ int main(int argc, char** argv) {
 
 	delete runManager;
 	dataManager->Dispose();
-	delete garfieldG4FastSimulationModel;
+	// The model owns garfieldPhysics; there is no model in the master thread
+	if (garfieldG4FastSimulationModel) {
+		delete garfieldG4FastSimulationModel;
+	} else {
+		delete garfieldPhysics;
+	}
 	return 0;
 }
 
@@ -0,0 +1,183 @@
+/// \file buildHeedLibrary.cc
+/// \brief Generates the Heed cluster library used by GarfieldPhysics
+//
+// Usage:
+//   buildHeedLibrary output.lib driftField_Vcm [tracksPerBin nEnergies EminKeV EmaxKeV nCosines]
+//
+// driftField_Vcm is the drift field argument of NeutronGEM (0: no field).
+// The gas is the one of GarfieldPhysics (GarfieldGas, same cache and
+// NEUTRONGEM_* environment variables), the field points to -z as in
+// the detector. Both are written in the library: GarfieldPhysics refuses
+// a library made for another gas or field.
+// The tracks start at the centre of a gas box large enough to contain
+// them (GarfieldGas::libraryBoxHalfSize_cm): the clusters are cut to the
+// drift gap when the library is used.
+// Electrons below 60 keV are transported with TrackElectron (clusters
+// only), above with TrackHeed, as in GarfieldPhysics::DoIt.
+//
+// Then in the NeutronGEM macro:
+//   /garfield/clusterLibrary output.lib
+//   /garfield/useClusterLibrary true
+// after checking the library against Heed (run/validate_heed_library.sh).
+
+#include "HeedClusterLibrary.hh"
+#include "GarfieldGas.hh"
+
+#include "MediumMagboltz.hh"
+#include "SolidBox.hh"
+#include "GeometrySimple.hh"
+#include "ComponentConstant.hh"
+#include "Sensor.hh"
+#include "TrackHeed.hh"
+#include "TrackElectron.hh"
+#include "Random.hh"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+	const double boxHalfSize_cm = GarfieldGas::libraryBoxHalfSize_cm;
+
+	/// Library frame of the track: position relative to the start
+	/// projected on the direction d and on the axes v, w
+	void ToTrackFrame(const double d[3], const double v[3], const double w[3],
+			double x, double y, double z, float& u, float& pv, float& pw) {
+		u = x * d[0] + y * d[1] + z * d[2];
+		pv = x * v[0] + y * v[1] + z * v[2];
+		pw = x * w[0] + y * w[1] + z * w[2];
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		std::cerr << "Usage: " << argv[0]
+				<< " output.lib driftField_Vcm [tracksPerBin nEnergies EminKeV EmaxKeV nCosines]"
+				<< std::endl;
+		return 1;
+	}
+	std::string fileName = argv[1];
+	double driftField_Vcm = atof(argv[2]);
+	int tracksPerBin = argc > 3 ? atoi(argv[3]) : 200;
+	int nEnergies = argc > 4 ? atoi(argv[4]) : 41;
+	double eminKeV = argc > 5 ? atof(argv[5]) : 1.;
+	double emaxKeV = argc > 6 ? atof(argv[6]) : 10000.;
+	int nCosines = argc > 7 ? atoi(argv[7]) : 10;
+
+	Garfield::MediumMagboltz* gas = GarfieldGas::Create(
+			GarfieldGas::DefaultCacheDir(),
+			GarfieldGas::DefaultIonMobilityFile(), std::cout);
+
+	Garfield::SolidBox* box = new Garfield::SolidBox(0., 0., 0.,
+			boxHalfSize_cm, boxHalfSize_cm, boxHalfSize_cm);
+	Garfield::GeometrySimple* geometry = new Garfield::GeometrySimple();
+	geometry->AddSolid(box, gas);
+	Garfield::ComponentConstant* field = new Garfield::ComponentConstant();
+	field->SetGeometry(geometry);
+	field->SetElectricField(0, 0, -driftField_Vcm);
+	Garfield::Sensor* sensor = new Garfield::Sensor();
+	sensor->AddComponent(field);
+	sensor->SetArea(-boxHalfSize_cm, -boxHalfSize_cm, -boxHalfSize_cm,
+			boxHalfSize_cm, boxHalfSize_cm, boxHalfSize_cm);
+
+	Garfield::TrackHeed* trackHeed = new Garfield::TrackHeed();
+	trackHeed->SetSensor(sensor);
+	trackHeed->EnableDeltaElectronTransport();
+	Garfield::TrackElectron* trackElectron = new Garfield::TrackElectron();
+	trackElectron->SetSensor(sensor);
+
+	HeedClusterLibrary::Builder builder(nEnergies, eminKeV, emaxKeV, nCosines);
+	builder.SetConditions(GarfieldGas::GetName(), driftField_Vcm,
+			boxHalfSize_cm);
+	for (int p = 0; p < HeedClusterLibrary::kNumberOfParticles; ++p) {
+		HeedClusterLibrary::Particle particle = (HeedClusterLibrary::Particle) p;
+		for (unsigned int ie = 0; ie < builder.GetNumberOfEnergies(); ++ie) {
+			double ekin_keV = builder.GetEnergy(ie);
+			std::cout << (particle == HeedClusterLibrary::kGamma ? "gamma " : "e- ")
+					<< ekin_keV << " keV" << std::endl;
+			for (unsigned int ic = 0; ic < builder.GetNumberOfCosines(); ++ic) {
+				double cosLow, cosHigh;
+				builder.GetCosineRange(ic, cosLow, cosHigh);
+				for (int n = 0; n < tracksPerBin; ++n) {
+					double cosTheta = cosLow
+							+ (cosHigh - cosLow) * Garfield::RndmUniform();
+					double sinTheta = std::sqrt(1 - cosTheta * cosTheta);
+					double phi = 2 * M_PI * Garfield::RndmUniform();
+					double d[3] = { sinTheta * std::cos(phi), sinTheta
+							* std::sin(phi), cosTheta };
+					double v[3], w[3];
+					HeedClusterLibrary::Frame(d, v, w);
+
+					builder.BeginTrack(particle, ie, ic);
+					HeedClusterLibrary::Cluster cluster;
+					HeedClusterLibrary::Electron electron;
+					double xc, yc, zc, tc, ec, extra;
+					int nc;
+					if (particle == HeedClusterLibrary::kGamma) {
+						// One cluster with all the electrons of the photon
+						trackHeed->TransportPhoton(0, 0, 0, 0, ekin_keV * 1000,
+								d[0], d[1], d[2], nc);
+						cluster.u = cluster.v = cluster.w = cluster.t = 0;
+						cluster.energy = 0;
+						cluster.nElectrons = nc;
+						builder.AddCluster(cluster);
+						for (int i = 0; i < nc; ++i) {
+							double xe, ye, ze, te, ee, dxe, dye, dze;
+							trackHeed->GetElectron(i, xe, ye, ze, te, ee, dxe,
+									dye, dze);
+							ToTrackFrame(d, v, w, xe, ye, ze, electron.u,
+									electron.v, electron.w);
+							ToTrackFrame(d, v, w, dxe, dye, dze, electron.du,
+									electron.dv, electron.dw);
+							electron.t = te;
+							electron.energy = ee;
+							builder.AddElectron(electron);
+						}
+					} else if (ekin_keV >= 60) {
+						trackHeed->SetParticle("e-");
+						trackHeed->SetKineticEnergy(ekin_keV * 1000);
+						trackHeed->NewTrack(0, 0, 0, 0, d[0], d[1], d[2]);
+						while (trackHeed->GetCluster(xc, yc, zc, tc, nc, ec,
+								extra)) {
+							ToTrackFrame(d, v, w, xc, yc, zc, cluster.u,
+									cluster.v, cluster.w);
+							cluster.t = tc;
+							cluster.energy = ec;
+							cluster.nElectrons = nc;
+							builder.AddCluster(cluster);
+							for (int i = 0; i < nc; ++i) {
+								double xe, ye, ze, te, ee, dxe, dye, dze;
+								trackHeed->GetElectron(i, xe, ye, ze, te, ee,
+										dxe, dye, dze);
+								ToTrackFrame(d, v, w, xe, ye, ze, electron.u,
+										electron.v, electron.w);
+								ToTrackFrame(d, v, w, dxe, dye, dze,
+										electron.du, electron.dv, electron.dw);
+								electron.t = te;
+								electron.energy = ee;
+								builder.AddElectron(electron);
+							}
+						}
+					} else {
+						trackElectron->SetParticle("e-");
+						trackElectron->SetKineticEnergy(ekin_keV * 1000);
+						trackElectron->NewTrack(0, 0, 0, 0, d[0], d[1], d[2]);
+						while (trackElectron->GetCluster(xc, yc, zc, tc, nc, ec,
+								extra)) {
+							ToTrackFrame(d, v, w, xc, yc, zc, cluster.u,
+									cluster.v, cluster.w);
+							cluster.t = tc;
+							cluster.energy = ec;
+							cluster.nElectrons = nc;
+							builder.AddCluster(cluster);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	if (!builder.Write(fileName)) return 1;
+	std::cout << "Heed cluster library written in " << fileName << std::endl;
+	return 0;
+}
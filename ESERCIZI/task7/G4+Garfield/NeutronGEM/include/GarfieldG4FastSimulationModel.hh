@@ -10,6 +10,7 @@
 
 #include "G4VFastSimulationModel.hh"
 #include "GarfieldPhysics.hh"
+#include <vector>
 
 class G4VPhysicalVolume;
 
@@ -24,17 +25,36 @@ public:
   ~GarfieldG4FastSimulationModel ();
 
   void SetPhysics(GarfieldPhysics* fGarfieldPhysics);
-  void WriteGeometryToGDML(G4VPhysicalVolume* physicalVolume);
 
   virtual G4bool IsApplicable(const G4ParticleDefinition&);
   virtual G4bool ModelTrigger(const G4FastTrack &);
   virtual void DoIt(const G4FastTrack&, G4FastStep&);
 
-
+  // Calls of ModelTrigger() and DoIt() since the last ResetCounters()
+  G4long GetNumberOfTriggers() const { return fNumberOfTriggers; }
+  G4long GetNumberOfDoIts() const { return fNumberOfDoIts; }
+  void ResetCounters() { fNumberOfTriggers = 0; fNumberOfDoIts = 0; }
 
 private:
+  // Particle handled by Garfield, with its kinetic energy window
+  struct Applicability {
+	  const G4ParticleDefinition* particle;
+	  G4double ekinMin, ekinMax;
+  };
+  // Entry of the particle, 0 if Garfield does not handle it
+  const Applicability* FindApplicability(const G4ParticleDefinition* particle) const {
+	  for (size_t i = 0; i < fApplicability.size(); ++i) {
+		  if (fApplicability[i].particle == particle) return &fApplicability[i];
+	  }
+	  return 0;
+  }
 
    GarfieldPhysics* fGarfieldPhysics;
+   // Filled by SetPhysics() from the particle names of GarfieldPhysics:
+   // a few entries, searched by pointer at each step in the region
+   std::vector<Applicability> fApplicability;
+   G4long fNumberOfTriggers;
+   G4long fNumberOfDoIts;
 };
 
 
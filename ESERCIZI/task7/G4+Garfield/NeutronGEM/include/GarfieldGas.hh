@@ -0,0 +1,55 @@
+/*
+ * GarfieldGas.hh
+ *
+ *  Drift gas shared by GarfieldPhysics and buildHeedLibrary
+ */
+
+#ifndef GARFIELDGAS_HH_
+#define GARFIELDGAS_HH_
+
+#include <iosfwd>
+#include <string>
+
+namespace Garfield {
+class MediumMagboltz;
+}
+
+/*!
+ * \brief The drift gas of the simulation, in one place.
+ *
+ * GarfieldPhysics and the buildHeedLibrary tool both create their gas
+ * here, from the same cache directory and ion mobility file (by default
+ * from the environment), so the Heed cluster library is generated in
+ * the gas of the simulation. GetName() identifies the gas: it is the
+ * name of the cache file and it is stored in the library, which
+ * GarfieldPhysics refuses if the names differ.
+ *
+ * No Geant4 dependence: the messages go to the stream given.
+ */
+class GarfieldGas {
+public:
+	/// Composition, temperature, pressure and field grid of the gas tables
+	static std::string GetName();
+	/// $NEUTRONGEM_GAS_CACHE, or ./gascache
+	static std::string DefaultCacheDir();
+	/// $NEUTRONGEM_ION_MOBILITY, or $GARFIELD_HOME/Data/IonMobility_Ar+_Ar.txt, or none
+	static std::string DefaultIonMobilityFile();
+
+	/*! \brief The gas, with its transport tables
+	 *
+	 * The tables depend on the composition, temperature, pressure and
+	 * field grid: they are computed by Magboltz only the first time and
+	 * saved in cacheDir/GetName().gas, the next starts read the file.
+	 */
+	static Garfield::MediumMagboltz* Create(const std::string& cacheDir,
+			const std::string& ionMobilityFile, std::ostream& log);
+
+	/// mkdir -p: create dir and its missing parents, false if it cannot be done
+	static bool MakeDirectories(const std::string& dir);
+
+	/// Half size (cm) of the gas box of the library tracks: "unbounded" gas,
+	/// larger than any drift gap, the clusters are cut to the gap at run time
+	static const double libraryBoxHalfSize_cm;
+};
+
+#endif /* GARFIELDGAS_HH_ */
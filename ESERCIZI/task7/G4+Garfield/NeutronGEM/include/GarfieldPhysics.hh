@@ -11,6 +11,7 @@
 #include <map>
 #include <vector>
 #include <iostream>
+#include <cmath>
 
 #include "Sensor.hh"
 #include "AvalancheMicroscopic.hh"
@@ -18,54 +19,188 @@
 #include "TrackHeed.hh"
 #include "TrackElectron.hh"
 #include "MediumMagboltz.hh"
-#include "GeometryRoot.hh"
+#include "GeometrySimple.hh"
+#include "SolidBox.hh"
+#include "HeedClusterLibrary.hh"
+
+class GarfieldPhysicsMessenger;
 
 typedef std::pair<double, double> EnergyRange_keV;
 typedef std::map< const std::string, EnergyRange_keV> MapParticlesEnergy;
 
-class GarfieldElectron{
+/*!
+ * \brief Secondary electrons of the last GarfieldPhysics::DoIt(),
+ * stored as a struct of arrays in Geant4 units (mm, ns, MeV).
+ *
+ * Clear() only resets the size: the arrays grow during the first tracks
+ * and are then reused, so Add() is a few stores and no allocation.
+ * The getters return the arrays, Size() elements long (0 if empty).
+ */
+class GarfieldElectronBuffer {
 public:
-	GarfieldElectron( double ekin_eV,double time, double x_cm,double y_cm,double z_cm, double dx,double dy,double dz):fEkin_MeV(ekin_eV/1000000), fTime(time), fx_mm(10*x_cm),fy_mm(10*y_cm), fz_mm(10*z_cm),  fdx(dx), fdy(dy), fdz(dz){}
-	~GarfieldElectron(){};
-
-	double getX_mm() {return fx_mm;}
-	double getY_mm(){return fy_mm;}
-	double getZ_mm(){return fz_mm;}
-	double getEkin_MeV(){return fEkin_MeV;}
-	double getTime(){return fTime;}
-	double getDX(){return fdx;}
-	double getDY(){return fdy;}
-	double getDZ(){return fdz;}
-
+	GarfieldElectronBuffer() : fSize(0) {}
+
+	void Clear() { fSize = 0; }
+	void Add(double ekin_eV, double time, double x_cm, double y_cm,
+			double z_cm, double dx, double dy, double dz) {
+		if (fSize == fEkin_MeV.size()) Grow();
+		fEkin_MeV[fSize] = ekin_eV / 1000000;
+		fTime[fSize] = time;
+		fX_mm[fSize] = 10 * x_cm;
+		fY_mm[fSize] = 10 * y_cm;
+		fZ_mm[fSize] = 10 * z_cm;
+		fDX[fSize] = dx;
+		fDY[fSize] = dy;
+		fDZ[fSize] = dz;
+		++fSize;
+	}
+
+	size_t Size() const { return fSize; }
+	const double* GetEkin_MeV() const { return Data(fEkin_MeV); }
+	const double* GetTime() const { return Data(fTime); }
+	const double* GetX_mm() const { return Data(fX_mm); }
+	const double* GetY_mm() const { return Data(fY_mm); }
+	const double* GetZ_mm() const { return Data(fZ_mm); }
+	const double* GetDX() const { return Data(fDX); }
+	const double* GetDY() const { return Data(fDY); }
+	const double* GetDZ() const { return Data(fDZ); }
 
 private:
-	double fEkin_MeV, fTime, fx_mm,fy_mm,fz_mm,fdx,fdy,fdz;
-
+	void Grow() {
+		size_t capacity = fSize > 0 ? 2 * fSize : 256;
+		fEkin_MeV.resize(capacity);
+		fTime.resize(capacity);
+		fX_mm.resize(capacity);
+		fY_mm.resize(capacity);
+		fZ_mm.resize(capacity);
+		fDX.resize(capacity);
+		fDY.resize(capacity);
+		fDZ.resize(capacity);
+	}
+	const double* Data(const std::vector<double>& v) const {
+		return fSize > 0 ? &v[0] : 0;
+	}
+
+	size_t fSize;
+	std::vector<double> fEkin_MeV, fTime, fX_mm, fY_mm, fZ_mm, fDX, fDY, fDZ;
 };
 
 
 class GarfieldPhysics {
 public:
 
-	GarfieldPhysics(const std::string);
+	/// Only the instance made in main() (no master) owns the /garfield/ commands
+	GarfieldPhysics(const std::string, GarfieldPhysics* master = 0);
 	~GarfieldPhysics();
 
+	/*! \brief Copy for a worker thread: particles and cluster library, not initialised.
+	 *
+	 * The clone has no messenger: the /garfield/ commands, issued in the
+	 * master thread, change this instance and it forwards them to its clones.
+	 * The Magboltz gas is computed once and shared by all the instances;
+	 * Heed and Magboltz have global state, so the initialisation and the
+	 * live Heed transport of the instances run one at a time: with live
+	 * Heed more threads give no speed-up in the drift gap, only the cluster
+	 * library (read without locks) scales with the threads.
+	 */
+	GarfieldPhysics* Clone();
+
 
 	void InitializePhysics();
 
-	void CreateGeometryFromGDML(std::string geometryFile, std::string gasMedium);
+	/// Drift gap: box of gas centred at the origin of its own frame,
+	/// the frame of the positions given to DoIt(). Set before InitializePhysics().
+	void SetDriftVolume(double halfX_cm, double halfY_cm, double halfZ_cm);
 
 	void DoIt(std::string particleName, double ekin_keV,double time,
 			double x_cm, double y_cm, double z_cm, double dx, double dy, double dz, bool createSecondaries);
 
 	void AddParticleName(const std::string particleName, double ekin_min_keV, double ekin_max_keV);
+	/// Add the particles of a list "name:min_keV:max_keV,..." ("none": no particle),
+	/// false if the list cannot be read. Before runManager->Initialize():
+	/// the physics list attaches the Garfield model to these particles
+	bool AddParticleNames(const std::string& list);
+	/// $NEUTRONGEM_GARFIELD_PARTICLES, or e- and gamma from 0 to 10 MeV
+	static std::string DefaultParticleNames();
 	bool FindParticleName(const std::string name);
 	bool FindParticleNameEnergy(std::string name, double ekin_keV);
-	std::vector<GarfieldElectron*>* GetSecondaryElectrons();
-	void DeleteSecondaryElectrons();
+	/// Particles handled by Garfield and their kinetic energy ranges (keV)
+	const MapParticlesEnergy& GetParticleEnergyRanges() const { return *fMapParticlesEnergy; }
+	const GarfieldElectronBuffer& GetSecondaryElectrons() const { return fSecondaryElectrons; }
+
+	/// Map the Heed cluster library (see HeedClusterLibrary), false if it
+	/// cannot be read or was made for another gas, field or drift gap
+	bool LoadClusterLibrary(const std::string& fileName);
+	/// Sample the clusters from the loaded library (true) or run Heed
+	/// (false, default: the library is validated with compareHeedLibrary.C)
+	void SetUseClusterLibrary(bool val);
+	bool GetUseClusterLibrary() const { return fUseClusterLibrary; }
+
+	/*! \name Gas settings
+	 *
+	 * Read when the gas is created, by the first InitializePhysics(): in a
+	 * sequential run main() initialises the kernel before any macro, so
+	 * only the defaults taken from the environment by the constructor
+	 * can be changed (NEUTRONGEM_GAS_CACHE, NEUTRONGEM_ION_MOBILITY).
+	 */
+	//@{
+	/// Directory of the cached Magboltz gas files (default: GarfieldGas::DefaultCacheDir())
+	void SetGasCacheDir(const std::string& dir);
+	/// Ion mobility file of the gas (default: GarfieldGas::DefaultIonMobilityFile()), empty: none
+	void SetIonMobilityFile(const std::string& file);
+	/// True once the gas shared by the instances exists: the settings above are too late
+	static bool IsGasCreated();
+	//@}
+
+	/// Strength (V/cm) of the drift field, set before InitializePhysics().
+	/// As the Geant4 field of the detector it points to -z (electrons drift
+	/// to +z); 0 (default, no field in the detector): no drift
+	void SetDriftField(double field_Vcm) { fDriftField_Vcm = field_Vcm; }
+	/// Drift the ionisation electrons to the readout plane (default true),
+	/// refused once initialised if the gas gives no drift velocity
+	void SetDriftElectrons(bool val);
+
+	/// The set and load functions above also act on the clones
 private:
+	/// Copy of the list of the clones, taken under the lock
+	std::vector<GarfieldPhysics*> GetClones() const;
+	/// Analytic box of the drift gap, filled with the gas
+	void CreateGeometry();
+	/// Clusters of an e- or gamma from the library, false if not in the library
+	bool DoItFromLibrary(const std::string& particleName, double ekin_keV,
+			double time, double x_cm, double y_cm, double z_cm, double dx,
+			double dy, double dz, bool createSecondaries);
+	/// True inside the sensor area (the drift gap)
+	bool InDrift(double x_cm, double y_cm, double z_cm) const {
+		return std::fabs(x_cm) <= fHalfX_cm && std::fabs(y_cm) <= fHalfY_cm
+				&& std::fabs(z_cm) <= fHalfZ_cm;
+	}
+	void AddSecondaryElectron(double x_cm, double y_cm, double z_cm,
+			double time, double ekin_eV, double dx, double dy, double dz);
+
+	/// Drift velocity, diffusion and attachment of the gas at the drift field
+	void InitializeDrift();
+	/// Ionisation electron of the current DoIt(), drifted by DriftElectrons()
+	void AddDriftElectron(double x_cm, double y_cm, double z_cm, double time) {
+		if (!fDriftElectrons || fDriftVelocity <= 0) return;
+		fDriftX.push_back(x_cm);
+		fDriftY.push_back(y_cm);
+		fDriftZ.push_back(z_cm);
+		fDriftT.push_back(time);
+	}
+	/*! \brief Parameterised drift of the electrons of the current DoIt()
+	 *
+	 * Instead of a microscopic avalanche, each electron moves against the
+	 * field (-z) to the readout plane z = +fHalfZ_cm with the tabulated
+	 * drift velocity, a Gaussian spread sigma = D sqrt(length) across and
+	 * along the drift and the survival probability exp(-eta length).
+	 * The electrons are processed as a batch over plain arrays, with the
+	 * random numbers drawn for the whole batch; the arrival positions and
+	 * times are filled in NeutronGEMHistoManager::FillReadout().
+	 */
+	void DriftElectrons();
+
 	MapParticlesEnergy* fMapParticlesEnergy;
-	TGeoManager* fGeoManager;
 	std::string fName;
 	Garfield::MediumMagboltz* fMediumMagboltz;
 	Garfield::Sensor* fSensor;
@@ -73,8 +208,26 @@ private:
 	Garfield::ComponentConstant* fComponentConstant;
 	Garfield::TrackHeed* fTrackHeed;
 	Garfield::TrackElectron* fTrackElectron;
-	Garfield::GeometryRoot* fGeometryRoot;
-	std::vector<GarfieldElectron*>* fSecondaryElectrons;
+	Garfield::SolidBox* fDriftBox;
+	Garfield::GeometrySimple* fGeometrySimple;
+	GarfieldElectronBuffer fSecondaryElectrons;
+	HeedClusterLibrary* fClusterLibrary;
+	bool fUseClusterLibrary;
+	double fHalfX_cm, fHalfY_cm, fHalfZ_cm;
+	std::string fGasCacheDir;
+	std::string fIonMobilityFile;
+	bool fDriftElectrons;
+	double fDriftField_Vcm;
+	/// Gas transport at the drift field: cm/ns, sqrt(cm), sqrt(cm), 1/cm
+	double fDriftVelocity, fDiffusionL, fDiffusionT, fAttachment;
+	/// Electrons to drift (cm, ns) and work arrays, reused from batch to batch
+	std::vector<double> fDriftX, fDriftY, fDriftZ, fDriftT;
+	std::vector<double> fDriftSigmaT, fDriftSigmaTime, fDriftSurvival;
+	std::vector<double> fGauss, fFlat;
+	/// Instance that made this clone (0 for the master) and the clones made by this one
+	GarfieldPhysics* fMaster;
+	std::vector<GarfieldPhysics*> fClones;
+	GarfieldPhysicsMessenger* fMessenger;
 
 
 };
@@ -0,0 +1,36 @@
+/// \file GarfieldPhysicsMessenger.hh
+/// \brief Definition of the GarfieldPhysicsMessenger class
+
+#ifndef GarfieldPhysicsMessenger_h
+#define GarfieldPhysicsMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class GarfieldPhysics;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+
+/// Messenger of GarfieldPhysics: /garfield/ commands
+
+class GarfieldPhysicsMessenger: public G4UImessenger
+{
+public:
+	GarfieldPhysicsMessenger(GarfieldPhysics*);
+	virtual ~GarfieldPhysicsMessenger();
+
+	virtual void SetNewValue(G4UIcommand*, G4String);
+
+private:
+	GarfieldPhysics* fGarfieldPhysics;
+
+	G4UIdirectory*      fGarfieldDir;
+	G4UIcmdWithAString* fLibraryCmd;
+	G4UIcmdWithABool*   fUseLibraryCmd;
+	G4UIcmdWithAString* fGasCacheCmd;
+	G4UIcmdWithAString* fIonMobilityCmd;
+	G4UIcmdWithABool*   fDriftCmd;
+};
+
+#endif
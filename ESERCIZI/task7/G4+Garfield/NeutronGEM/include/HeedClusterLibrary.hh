@@ -0,0 +1,165 @@
+/*
+ * HeedClusterLibrary.hh
+ *
+ *  Pre-generated Heed clusters in the drift gas
+ */
+
+#ifndef HEEDCLUSTERLIBRARY_HH_
+#define HEEDCLUSTERLIBRARY_HH_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*!
+ * \brief Library of ionisation clusters generated offline with Heed.
+ *
+ * For a fixed gas the clusters of a track depend only on the particle,
+ * its energy and its direction. The library stores, for each bin of
+ * (particle, log10 energy, cosine of the direction with the drift axis),
+ * a set of tracks generated in an unbounded gas volume by the tool
+ * buildHeedLibrary, in the gas of the simulation (GarfieldGas) at its
+ * drift field; both are stored in the header and checked when loaded. Each track is a list of clusters and each cluster
+ * the Heed electrons (TrackElectron clusters have no electrons).
+ * Positions are in the frame of the track: u along the direction,
+ * v and w along the axes given by Frame(), origin and time at the start.
+ *
+ * At run time a track of the right bin is picked at random and moved
+ * to the position and direction of the Geant4 track (GarfieldPhysics),
+ * with a random rotation around the direction.
+ * Between two energies the bin is chosen at random, with probability
+ * linear in log10(E), so the distributions are interpolated.
+ *
+ * The file is memory mapped read-only: opening it costs nothing and
+ * the pages are shared by all the processes reading the same library.
+ * Layout (native endianness): Header, Bin[nBins], Track[nTracks],
+ * Cluster[nClusters], Electron[nElectrons].
+ *
+ * The class does not depend on Geant4: the random numbers are given
+ * by the caller, and the builder tool links it without Geant4.
+ */
+class HeedClusterLibrary {
+public:
+	enum Particle { kElectron = 0, kGamma = 1, kNumberOfParticles = 2 };
+
+	struct Header {
+		char magic[8];		//!< "HEEDLIB"
+		uint32_t version;
+		uint32_t nEnergies;
+		uint32_t nCosines;
+		float log10EminKeV;
+		float log10EmaxKeV;
+		uint32_t nBins;
+		uint32_t nTracks;
+		uint32_t nClusters;
+		uint32_t nElectrons;
+		char gas[96];		//!< GarfieldGas::GetName() of the gas
+		float driftField_Vcm;	//!< drift field (along -z)
+		float halfSize_cm;	//!< half size of the gas box of the tracks
+	};
+	struct Bin {
+		uint32_t firstTrack;
+		uint32_t nTracks;
+	};
+	struct Track {
+		uint32_t firstCluster;
+		uint32_t nClusters;
+	};
+	struct Cluster {
+		float u, v, w, t;	//!< cm, ns
+		float energy;		//!< energy loss (eV)
+		uint32_t nElectrons;	//!< electrons produced
+		uint32_t firstElectron;
+		uint32_t nStored;	//!< electrons in the library (0: TrackElectron cluster)
+	};
+	struct Electron {
+		float u, v, w, t;	//!< cm, ns
+		float energy;		//!< eV
+		float du, dv, dw;	//!< direction
+	};
+
+	HeedClusterLibrary();
+	~HeedClusterLibrary();
+
+	//! Map the library file, false if it cannot be read
+	bool Open(const std::string& fileName);
+	void Close();
+	bool IsOpen() const { return fHeader != 0; }
+	const std::string& GetFileName() const { return fFileName; }
+	//! \name Conditions of the generation, checked by GarfieldPhysics
+	//@{
+	std::string GetGasName() const { return fHeader ? fHeader->gas : ""; }
+	double GetDriftField() const { return fHeader ? fHeader->driftField_Vcm : 0; }
+	double GetHalfSize() const { return fHeader ? fHeader->halfSize_cm : 0; }
+	//@}
+
+	/*! \brief Bin of this particle, energy and direction cosine
+	 *
+	 * random (in [0,1)) chooses between the two closest energies.
+	 * -1 outside the energy range or if the bin is empty.
+	 */
+	int GetBin(Particle particle, double ekin_keV, double cosine,
+			double random) const;
+	//! A track of the bin, random in [0,1)
+	const Track& SampleTrack(int bin, double random) const;
+	const Cluster* GetClusters(const Track& track) const {
+		return fClusters + track.firstCluster;
+	}
+	const Electron* GetElectrons(const Cluster& cluster) const {
+		return fElectrons + cluster.firstElectron;
+	}
+
+	//! Axes v, w orthogonal to the direction d (unit vector)
+	static void Frame(const double d[3], double v[3], double w[3]);
+
+	/*!
+	 * \brief Collects the tracks generated with Heed and writes the file.
+	 *
+	 * Used by the buildHeedLibrary tool. The tracks can be added in any
+	 * order, they are grouped by bin when writing.
+	 */
+	class Builder {
+	public:
+		Builder(unsigned int nEnergies, double eminKeV, double emaxKeV,
+				unsigned int nCosines);
+		//! Energy of the energy node ie
+		double GetEnergy(unsigned int ie) const;
+		//! Cosine range of the cosine bin ic
+		void GetCosineRange(unsigned int ic, double& low, double& high) const;
+		unsigned int GetNumberOfEnergies() const { return fHeader.nEnergies; }
+		unsigned int GetNumberOfCosines() const { return fHeader.nCosines; }
+		//! Gas (GarfieldGas::GetName()), field and gas box of the generation
+		void SetConditions(const std::string& gasName, double driftField_Vcm,
+				double halfSize_cm);
+
+		void BeginTrack(Particle particle, unsigned int ie, unsigned int ic);
+		//! Add a cluster to the current track
+		void AddCluster(const Cluster& cluster);
+		//! Add an electron to the current cluster
+		void AddElectron(const Electron& electron);
+		bool Write(const std::string& fileName) const;
+	private:
+		Header fHeader;
+		std::vector<uint32_t> fTrackBin;
+		std::vector<Track> fTracks;
+		std::vector<Cluster> fClusters;
+		std::vector<Electron> fElectrons;
+	};
+
+private:
+	static unsigned int BinIndex(const Header& header, unsigned int particle,
+			unsigned int ie, unsigned int ic) {
+		return (particle * header.nEnergies + ie) * header.nCosines + ic;
+	}
+
+	std::string fFileName;
+	void* fMap;
+	size_t fMapSize;
+	const Header* fHeader;
+	const Bin* fBins;
+	const Track* fTracks;
+	const Cluster* fClusters;
+	const Electron* fElectrons;
+};
+
+#endif /* HEEDCLUSTERLIBRARY_HH_ */
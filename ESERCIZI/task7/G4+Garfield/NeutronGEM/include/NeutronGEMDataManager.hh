@@ -38,6 +38,11 @@
 
 class NeutronGEMHistoManager;
 
+/// One instance per thread. The master instance holds the configuration
+/// set by main(); the instance of a worker thread copies it when created
+/// and gets its own HistoManager, so the counters and the histograms of
+/// the workers are independent (merged by the master HistoManager).
+
 class NeutronGEMDataManager {
 public:
 	// With description
@@ -77,17 +82,38 @@ public:
 	G4int* getCounters();
 	void increaseCounter(int number);
 
+	// The counters and the per-event sums of the HistoManager describe one
+	// primary. EndOfPrimary() fills the histograms of the primary and adds
+	// its counters to the ones of the event; EndOfEvent() fills the single
+	// tree entry of the event.
+	// BeginOfPrimary() closes the record of the previous primary, if any:
+	// the primaries must be tracked one after the other, each with all its
+	// secondaries, see NeutronGEMTrackingAction.
+	void BeginOfEvent();
+	void EndOfEvent();
+	void BeginOfPrimary(G4int index);
+	void EndOfPrimary();
+	// Index of the primary being tracked, -1 before the first one
+	G4int getPrimaryIndex();
+
 private:
 	NeutronGEMDataManager();
 	~NeutronGEMDataManager();
+	void copyConfiguration(const NeutronGEMDataManager* master);
 
 	G4String fDescription;
 	G4String fFilenameGDML;
 	G4double fNumberOfEvents;
 
 	NeutronGEMHistoManager* fHistoManager;
-	static NeutronGEMDataManager* fDataManager;
+	static G4ThreadLocal NeutronGEMDataManager* fDataManager;
+	static NeutronGEMDataManager* fMasterDataManager;
 	G4int* fCounters;
+	// Counters of the event: sums of the counters of its primaries
+	G4int* fEventCounters;
+	G4int fPrimariesInEvent;
+	G4bool fPrimaryOpen;
+	G4int fPrimaryIndex;
 
 
 	G4double fCathodeThickness;
@@ -38,27 +38,37 @@ class G4VPhysicalVolume;
 class G4LogicalVolume;
 class NeutronGEMDataManager;
 class GarfieldG4FastSimulationModel;
+class GarfieldPhysics;
 class G4Material;
 class G4Box;
+class G4Region;
 
 
 /// Detector construction class to define materials and geometry.
 ///
 /// Crystals are positioned in Ring, with an appropriate rotation matrix. 
 /// Several copies of Ring are placed in the full detector.
+///
+/// The drift field and the Garfield fast simulation model are created
+/// in ConstructSDandField(), once per thread: a worker thread gets a
+/// clone of the GarfieldPhysics given to the constructor.
 
 class NeutronGEMDetectorConstruction: public G4VUserDetectorConstruction {
 
 public:
-	NeutronGEMDetectorConstruction();
+	NeutronGEMDetectorConstruction(GarfieldPhysics* garfieldPhysics);
 	virtual ~NeutronGEMDetectorConstruction();
-	GarfieldG4FastSimulationModel* GetGarfieldG4FastSimulationModel();
+	/// Model of the calling thread, 0 in the master of a multithreaded run
+	static GarfieldG4FastSimulationModel* GetGarfieldG4FastSimulationModel();
 public:
 	virtual G4VPhysicalVolume* Construct();
+	virtual void ConstructSDandField();
 private:
 	G4bool fCheckOverlaps;
 	NeutronGEMDataManager* fDataManager;
-	GarfieldG4FastSimulationModel* fGarfieldG4FastSimulationModel;
+	GarfieldPhysics* fGarfieldPhysics;
+	G4Region* fRegionGarfield;
+	static G4ThreadLocal GarfieldG4FastSimulationModel* fGarfieldG4FastSimulationModel;
 
 	void DefineMaterials();
 	void CreateScorers();
@@ -50,9 +50,6 @@ class NeutronGEMEventAction : public G4UserEventAction
 
     virtual void  BeginOfEventAction(const G4Event*);
     virtual void    EndOfEventAction(const G4Event*);
-    
-  private:
-    G4int fPrintModulo;   
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -38,6 +38,7 @@
 
 #include "globals.hh"
 #include "G4DataVector.hh"
+#include <map>
 #include <vector>
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -52,6 +53,11 @@ class G4Step;
 class G4ElectronIonPair;
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+/// In a multithreaded run each worker thread books its own file,
+/// <description>_<events>_<time>_t<thread>.root, and the master save()
+/// merges them, in the order of the threads, in the file of the run
+/// (the one of a sequential run); the files of the workers are removed.
+
 class NeutronGEMHistoManager {
 public:
 
@@ -60,16 +66,22 @@ public:
 
 	void book();
 	void save();
-	void fillTree(G4int* counters);
+	/// One tree entry per event: counters summed over the primaries,
+	/// the Events* branches count the primaries with a non zero counter
+	void fillTree(G4int* counters, G4int primaries);
 	void fillHistogram(G4int number, G4double value);
 
 	void Fill3DEnergyElectrons(G4int id, G4double xbin, G4double ybin,
 			G4double zbin, G4double weight);
 	void Fill2DPositionArrivalDrift(G4int id, G4double xbin, G4double ybin,
 			G4double weight = 1);
+	/// Drift electron at the readout plane (cm, ns), see GarfieldPhysics
+	void FillReadout(G4double x_cm, G4double y_cm, G4double t_ns);
 
 	void EndOfRun();
 
+	/// Reset / histogram the sums of one primary (histograms 21-30 are
+	/// filled per primary, as with one primary per event)
 	void BeginOfEvent();
 	void EndOfEvent();
 
@@ -87,12 +99,24 @@ public:
 
 private:
 
+	void mergeWorkerFiles();
+
+	/// File of the run without ".root", set by the master book()
+	static G4String fRunFileBase;
+	/// Files saved by the workers, by thread ID
+	static std::map<G4int, G4String> fWorkerFiles;
+
+	G4String fFileName;
 	TFile* rootFile;
 	TTree* fTree;
-	TH1D* fHisto[NUM_HISTOGRAMS];
-	TH3D* histo3DEnergyElectrons[NUM_HISTOGRAMS_3D];
-	TH2D* histo2DPositionArrivalDrift[NUM_HISTOGRAMS_2D];
-
+	// Histograms are numbered from 1
+	TH1D* fHisto[NUM_HISTOGRAMS + 1];
+	TH3D* histo3DEnergyElectrons[NUM_HISTOGRAMS_3D + 1];
+	TH2D* histo2DPositionArrivalDrift[NUM_HISTOGRAMS_2D + 1];
+	TH2D* histo2DReadout;
+	TH1D* fHistoArrivalTime;
+
+	G4int Primaries;
 	G4int NeutronCapture;
 	G4int ConversionElectronsCreatedConverter;
 	G4int AlphasCreatedConverter;
@@ -36,6 +36,7 @@
 
 class G4GeneralParticleSource;
 class G4Event;
+class NeutronGEMPrimaryGeneratorMessenger;
 
 
 /// The primary generator action class with particle gum.
@@ -43,6 +44,9 @@ class G4Event;
 /// It defines an ion (F18), at rest, randomly distribued within a zone 
 /// in a patient defined in GeneratePrimaries(). Ion F18 can be changed 
 /// with the G4ParticleGun commands (see run2.mac).
+///
+/// Several independent primaries can be generated in each event
+/// (/generator/primariesPerEvent) to share the per-event overhead.
 
 class NeutronGEMPrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
@@ -52,8 +56,12 @@ class NeutronGEMPrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 
     void GeneratePrimaries(G4Event* anEvent);      
 
+    void SetPrimariesPerEvent(G4int val) { fPrimariesPerEvent = val; }
+
   private:
     G4GeneralParticleSource*  fParticleSource;
+    G4int                     fPrimariesPerEvent;
+    NeutronGEMPrimaryGeneratorMessenger* fMessenger;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
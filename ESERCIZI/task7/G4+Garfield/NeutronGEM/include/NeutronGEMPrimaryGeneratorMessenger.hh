@@ -0,0 +1,31 @@
+/// \file NeutronGEMPrimaryGeneratorMessenger.hh
+/// \brief Definition of the NeutronGEMPrimaryGeneratorMessenger class
+
+#ifndef NeutronGEMPrimaryGeneratorMessenger_h
+#define NeutronGEMPrimaryGeneratorMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class NeutronGEMPrimaryGeneratorAction;
+class G4UIdirectory;
+class G4UIcmdWithAnInteger;
+
+/// Messenger of NeutronGEMPrimaryGeneratorAction: /generator/ commands
+
+class NeutronGEMPrimaryGeneratorMessenger: public G4UImessenger
+{
+public:
+	NeutronGEMPrimaryGeneratorMessenger(NeutronGEMPrimaryGeneratorAction*);
+	virtual ~NeutronGEMPrimaryGeneratorMessenger();
+
+	virtual void SetNewValue(G4UIcommand*, G4String);
+
+private:
+	NeutronGEMPrimaryGeneratorAction* fGenerator;
+
+	G4UIdirectory*        fGeneratorDir;
+	G4UIcmdWithAnInteger* fPrimariesCmd;
+};
+
+#endif
@@ -25,6 +25,10 @@ public:
 
   G4ParticleDefinition* GetParticleDefinition() {return fParticleDefinition;}
   G4double GetKineticEnergy() {return fOriginalEnergy; }
+  G4int GetOriginalTrackID() const {return fOriginalTrackID; }
+  // Index of the primary in the event (several primaries per event)
+  void SetPrimaryIndex(G4int index) {fPrimaryIndex = index; }
+  G4int GetPrimaryIndex() const {return fPrimaryIndex; }
 
 
 private:
@@ -35,6 +39,7 @@ private:
   G4ThreeVector         fOriginalMomentum;
   G4double              fOriginalEnergy;
   G4double              fOriginalTime;
+  G4int                 fPrimaryIndex;
 
 
 
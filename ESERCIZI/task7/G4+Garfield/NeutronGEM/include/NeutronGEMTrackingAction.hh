@@ -3,6 +3,20 @@
 
 #include "G4UserTrackingAction.hh"
 
+/// Tracking action class
+///
+/// The daughters of a primary get a NeutronGEMTrackInformation describing
+/// themselves (the "ancestor" of the tracks below them), passed on to all
+/// their descendants.
+/// With several primaries per event the start of a primary closes the record
+/// of the previous one (NeutronGEMDataManager::BeginOfPrimary()). This relies
+/// on the ordering of the G4StackManager: all tracks being urgent
+/// (NeutronGEMStackingAction) and the urgent stack being LIFO, every
+/// secondary of a primary is tracked before the next primary is popped
+/// (the primaries themselves may come in any order). This is checked: a
+/// secondary of an already closed primary, e.g. after a waiting stack is
+/// added to the stacking action, is a fatal exception.
+
 class NeutronGEMTrackingAction : public G4UserTrackingAction
 {
 public:
@@ -12,6 +26,9 @@ public:
   virtual void PreUserTrackingAction(const G4Track*);
   virtual void PostUserTrackingAction(const G4Track*);
 
+private:
+  G4int fPrimaryTrackID;
+
 };
 
 #endif
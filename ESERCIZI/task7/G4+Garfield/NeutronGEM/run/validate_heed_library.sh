@@ -0,0 +1,34 @@
+# Compare the Heed cluster library with live Heed on the gas histograms
+# (21, 24 and 26-30) before switching /garfield/useClusterLibrary on.
+# The library is built for the drift field of the runs if it does not exist:
+#   ../buildHeedLibrary heed.lib $FIELD
+# Garfield handles e- and gamma in both runs (NEUTRONGEM_GARFIELD_PARTICLES).
+# The result is kept in HeedValidation.log; the exit status is 0 only if
+# all the histograms agree.
+# Usage: sh validate_heed_library.sh [library [driftField_Vcm]]
+# Live Heed is serialised between the threads (Heed is not thread safe),
+# so the first run does not get faster with NEUTRONGEM_THREADS; the library does.
+LIBRARY=${1:-heed.lib}
+FIELD=${2:-1000}
+export NEUTRONGEM_HEED_LIBRARY=$LIBRARY
+export NEUTRONGEM_GARFIELD_PARTICLES="e-:0:10000,gamma:0:10000"
+
+if [ ! -f $LIBRARY ]; then
+	../buildHeedLibrary $LIBRARY $FIELD || exit 1
+fi
+
+START=`date +%s`
+../NeutronGEM ../macros/validate_heed.mac HeedValidation_heed Gd Al CsI 10 0.01 0 10 $FIELD
+MIDDLE=`date +%s`
+../NeutronGEM ../macros/validate_library.mac HeedValidation_library Gd Al CsI 10 0.01 0 10 $FIELD
+END=`date +%s`
+
+HEED=`ls -t HeedValidation_heed_*.root | grep -v '_t[0-9]*\.root$' | head -1`
+LIB=`ls -t HeedValidation_library_*.root | grep -v '_t[0-9]*\.root$' | head -1`
+{
+	echo "Library $LIBRARY, drift field $FIELD V/cm"
+	echo "Heed run $HEED: `expr $MIDDLE - $START` s"
+	echo "Library run $LIB: `expr $END - $MIDDLE` s"
+	root -l -b -q "compareHeedLibrary.C(\"$HEED\",\"$LIB\")"
+} 2>&1 | tee HeedValidation.log
+grep -q "^0 histograms differ" HeedValidation.log
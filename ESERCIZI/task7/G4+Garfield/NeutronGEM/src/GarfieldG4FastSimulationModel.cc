@@ -7,20 +7,22 @@
 #include <iostream>
 #include "GarfieldG4FastSimulationModel.hh"
 #include "G4VPhysicalVolume.hh"
-#include "/home/g4user/g4/geant4.10.00.p02/source/persistency/gdml/include/G4GDMLParser.hh"
 #include "G4Electron.hh"
+#include "G4ParticleTable.hh"
 #include "G4Gamma.hh"
 
 #include "G4SystemOfUnits.hh"
 
 GarfieldG4FastSimulationModel::GarfieldG4FastSimulationModel(G4String modelName,
 		G4Region* envelope) :
-		G4VFastSimulationModel(modelName, envelope) {
+		G4VFastSimulationModel(modelName, envelope), fGarfieldPhysics(0),
+		fNumberOfTriggers(0), fNumberOfDoIts(0) {
 
 }
 
 GarfieldG4FastSimulationModel::GarfieldG4FastSimulationModel(G4String modelName) :
-		G4VFastSimulationModel(modelName) {
+		G4VFastSimulationModel(modelName), fGarfieldPhysics(0),
+		fNumberOfTriggers(0), fNumberOfDoIts(0) {
 
 }
 
@@ -31,49 +33,52 @@ GarfieldG4FastSimulationModel::~GarfieldG4FastSimulationModel() {
 void GarfieldG4FastSimulationModel::SetPhysics(GarfieldPhysics* modelPhysics) {
 	fGarfieldPhysics = modelPhysics;
 	fGarfieldPhysics->InitializePhysics();
-}
-
-void GarfieldG4FastSimulationModel::WriteGeometryToGDML(
-		G4VPhysicalVolume* physicalVolume) {
 
-	G4GDMLParser* parser = new G4GDMLParser();
-	remove("drift.gdml");
-	parser->Write("drift.gdml", physicalVolume, false);
-	delete parser;
+	fApplicability.clear();
+	G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+	const MapParticlesEnergy& ranges =
+			fGarfieldPhysics->GetParticleEnergyRanges();
+	for (MapParticlesEnergy::const_iterator it = ranges.begin();
+			it != ranges.end(); ++it) {
+		G4ParticleDefinition* particle = particleTable->FindParticle(
+				it->first);
+		if (!particle) {
+			G4cout << "Garfield model: unknown particle " << it->first
+					<< G4endl;
+			continue;
+		}
+		Applicability applicability;
+		applicability.particle = particle;
+		applicability.ekinMin = it->second.first * keV;
+		applicability.ekinMax = it->second.second * keV;
+		fApplicability.push_back(applicability);
+	}
 }
 
 G4bool GarfieldG4FastSimulationModel::IsApplicable(
 			const G4ParticleDefinition& particleType) {
-	G4String particleName = particleType.GetParticleName();
-	//G4cout << "\nGarfield model applicable for " << particleName << "?"
-	//		<< G4endl;
-	if (fGarfieldPhysics->FindParticleName(particleName) ) {
-		//G4cout << "YES!\n" << G4endl;
-		return true;
-	}
-	//G4cout << "NO!\n" << G4endl;
-	return false;
-
+	return FindApplicability(&particleType) != 0;
 }
 
 G4bool GarfieldG4FastSimulationModel::ModelTrigger(
 		const G4FastTrack& fastTrack) {
-	double ekin_keV = fastTrack.GetPrimaryTrack()->GetKineticEnergy() / keV;
-	G4String particleName =
-			fastTrack.GetPrimaryTrack()->GetParticleDefinition()->GetParticleName();
-	if(fastTrack.GetPrimaryTrack()->GetParentID() != 0)
-	{
-		return fGarfieldPhysics->FindParticleNameEnergy(particleName, ekin_keV);
+	++fNumberOfTriggers;
+	const G4Track* track = fastTrack.GetPrimaryTrack();
+	if (track->GetParentID() == 0) {
+		return false;
 	}
-	else
-	{
+	const Applicability* applicability = FindApplicability(
+			track->GetParticleDefinition());
+	if (!applicability) {
 		return false;
 	}
-
+	G4double ekin = track->GetKineticEnergy();
+	return applicability->ekinMin <= ekin && ekin <= applicability->ekinMax;
 }
 
 void GarfieldG4FastSimulationModel::DoIt(const G4FastTrack& fastTrack,
 		G4FastStep& fastStep) {
+	++fNumberOfDoIts;
 
 	G4TouchableHandle theTouchable =
 			fastTrack.GetPrimaryTrack()->GetTouchableHandle();
@@ -100,34 +105,29 @@ void GarfieldG4FastSimulationModel::DoIt(const G4FastTrack& fastTrack,
 			localPosition.z() / CLHEP::cm, localdir.x(), localdir.y(),
 			localdir.z(), false);
 
-	std::vector<GarfieldElectron*>* secondaryElectrons =
+	const GarfieldElectronBuffer& secondaryElectrons =
 			fGarfieldPhysics->GetSecondaryElectrons();
+	const size_t nSecondaries = secondaryElectrons.Size();
+
+	if (nSecondaries > 0) {
+		fastStep.SetNumberOfSecondaryTracks(nSecondaries);
+
+		const double* x = secondaryElectrons.GetX_mm();
+		const double* y = secondaryElectrons.GetY_mm();
+		const double* z = secondaryElectrons.GetZ_mm();
+		const double* eKin_MeV = secondaryElectrons.GetEkin_MeV();
+		const double* dx = secondaryElectrons.GetDX();
+		const double* dy = secondaryElectrons.GetDY();
+		const double* dz = secondaryElectrons.GetDZ();
 
-	if (secondaryElectrons->size() > 0) {
-		fastStep.SetNumberOfSecondaryTracks(secondaryElectrons->size());
-
-		G4double totalEnergySecondaries_MeV = 0;
-
-		for (std::vector<GarfieldElectron*>::iterator it =
-				secondaryElectrons->begin(); it != secondaryElectrons->end();
-				++it) {
-			G4double x = (*it)->getX_mm();
-			G4double y = (*it)->getY_mm();
-			G4double z = (*it)->getZ_mm();
-			G4double eKin_MeV = (*it)->getEkin_MeV();
-			G4double dx = (*it)->getDX();
-			G4double dy = (*it)->getDY();
-			G4double dz = (*it)->getDZ();
-			G4double time = (*it)->getTime();
-			G4cout << "time " << time << " globaltime " << globalTime << G4endl;
-			G4ThreeVector momentumDirection(dx, dy, dz);
-			G4ThreeVector position(x, y, z);
+		for (size_t i = 0; i < nSecondaries; ++i) {
+			G4ThreeVector momentumDirection(dx[i], dy[i], dz[i]);
+			G4ThreeVector position(x[i], y[i], z[i]);
 
 			G4DynamicParticle electron(G4Electron::ElectronDefinition(),
-					momentumDirection, eKin_MeV);
+					momentumDirection, eKin_MeV[i]);
 
 			fastStep.CreateSecondaryTrack(electron, position, globalTime, true);
-			totalEnergySecondaries_MeV += eKin_MeV;
 		}
 	}
 
@@ -0,0 +1,112 @@
+/*
+ * GarfieldGas.cc
+ *
+ *  Drift gas shared by GarfieldPhysics and buildHeedLibrary
+ */
+
+#include "GarfieldGas.hh"
+
+#include "MediumMagboltz.hh"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+	const double fractionAr = 70.;
+	const double fractionCO2 = 30.;
+	const double temperature = 293.15;	// K
+	const double pressure = 760.;		// Torr
+
+	// Electric field grid of the gas tables (V/cm, log spacing)
+	const double gasFieldMin = 100.;
+	const double gasFieldMax = 100000.;
+	const int gasFieldPoints = 20;
+}
+
+const double GarfieldGas::libraryBoxHalfSize_cm = 50.;
+
+std::string GarfieldGas::GetName() {
+	std::ostringstream name;
+	name << "ar" << fractionAr << "_co2" << fractionCO2 << "_T" << temperature
+			<< "_p" << pressure << "_E" << gasFieldMin << "-" << gasFieldMax
+			<< "x" << gasFieldPoints;
+	return name.str();
+}
+
+std::string GarfieldGas::DefaultCacheDir() {
+	if (getenv("NEUTRONGEM_GAS_CACHE")) return getenv("NEUTRONGEM_GAS_CACHE");
+	return "gascache";
+}
+
+std::string GarfieldGas::DefaultIonMobilityFile() {
+	if (getenv("NEUTRONGEM_ION_MOBILITY")) {
+		return getenv("NEUTRONGEM_ION_MOBILITY");
+	}
+	if (getenv("GARFIELD_HOME")) {
+		return std::string(getenv("GARFIELD_HOME"))
+				+ "/Data/IonMobility_Ar+_Ar.txt";
+	}
+	return "";
+}
+
+Garfield::MediumMagboltz* GarfieldGas::Create(const std::string& cacheDir,
+		const std::string& ionMobilityFile, std::ostream& log) {
+	Garfield::MediumMagboltz* gas = new Garfield::MediumMagboltz();
+	gas->SetComposition("ar", fractionAr, "co2", fractionCO2);
+	gas->SetTemperature(temperature);
+	gas->SetPressure(pressure);
+	gas->SetFieldGrid(gasFieldMin, gasFieldMax, gasFieldPoints, true);
+
+	const std::string gasFile = cacheDir + "/" + GetName() + ".gas";
+
+	if (std::ifstream(gasFile.c_str()).good() && gas->LoadGasFile(gasFile)) {
+		log << "Gas tables read from " << gasFile << std::endl;
+	} else {
+		log << "Gas tables not in " << cacheDir
+				<< ", running Magboltz (only this time)" << std::endl;
+		gas->GenerateGasTable(10);
+		MakeDirectories(cacheDir);
+		// Jobs started together may write the same file: each one writes
+		// its own copy and renames it, a reader never sees half a file
+		std::ostringstream tmpName;
+		tmpName << gasFile << "." << getpid();
+		const std::string tmpFile = tmpName.str();
+		if (gas->WriteGasFile(tmpFile)
+				&& rename(tmpFile.c_str(), gasFile.c_str()) == 0) {
+			log << "Gas tables saved in " << gasFile << std::endl;
+		} else {
+			remove(tmpFile.c_str());
+			log << "Gas tables cannot be saved in " << cacheDir << std::endl;
+		}
+	}
+
+	// Set the Penning transfer efficiency.
+	const double rPenning = 0.57;
+	const double lambdaPenning = 0.;
+	gas->EnablePenningTransfer(rPenning, lambdaPenning, "ar");
+	// Load the ion mobilities.
+	if (!ionMobilityFile.empty()) {
+		gas->LoadIonMobility(ionMobilityFile);
+	}
+	return gas;
+}
+
+bool GarfieldGas::MakeDirectories(const std::string& dir) {
+	// Each prefix ending before a '/', then the whole path
+	for (size_t pos = dir.find('/', 1); ; pos = dir.find('/', pos + 1)) {
+		const std::string path = dir.substr(0, pos);
+		struct stat info;
+		if (stat(path.c_str(), &info) != 0
+				&& mkdir(path.c_str(), 0755) != 0 && errno != EEXIST) {
+			return false;
+		}
+		if (pos == std::string::npos) break;
+	}
+	return true;
+}
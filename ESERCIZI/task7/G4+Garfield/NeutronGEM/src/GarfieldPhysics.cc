@@ -1,34 +1,130 @@
 #include "GarfieldPhysics.hh"
+#include "GarfieldPhysicsMessenger.hh"
+#include "GarfieldGas.hh"
 
-#include "TGeoManager.h"
-#include "/home/g4user/root/root/geom/gdml/inc/TGDMLParse.h"
 #include "NeutronGEMDataManager.hh"
 #include "NeutronGEMHistoManager.hh"
-#include "TGeoBBox.h"
 
 #include "G4SystemOfUnits.hh"
+#include "G4AutoLock.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+	// Magboltz (Fortran common blocks) and Heed are global
+	G4Mutex garfieldMutex = G4MUTEX_INITIALIZER;
+	// Gas tables shared by the instances of all the threads
+	Garfield::MediumMagboltz* sharedMediumMagboltz = 0;
+	int sharedMediumUsers = 0;
+}
 
-GarfieldPhysics::GarfieldPhysics(const std::string configName) :
-		fName(configName) {
+GarfieldPhysics::GarfieldPhysics(const std::string configName,
+		GarfieldPhysics* master) :
+		fName(configName), fMediumMagboltz(0), fSensor(0),
+		fAvalalancheMicroscopic(0), fComponentConstant(0), fTrackHeed(0),
+		fTrackElectron(0), fDriftBox(0), fGeometrySimple(0), fClusterLibrary(0),
+		fUseClusterLibrary(false), fHalfX_cm(0), fHalfY_cm(0), fHalfZ_cm(0),
+		fGasCacheDir(GarfieldGas::DefaultCacheDir()),
+		fIonMobilityFile(GarfieldGas::DefaultIonMobilityFile()),
+		fDriftElectrons(true), fDriftField_Vcm(0),
+		fDriftVelocity(0), fDiffusionL(0), fDiffusionT(0), fAttachment(0),
+		fMaster(master), fMessenger(0) {
 	fMapParticlesEnergy = new MapParticlesEnergy();
-	fSecondaryElectrons = new std::vector<GarfieldElectron*>();
+	// A clone registering the commands again in its worker would not
+	// see the commands of the master: the master forwards them instead
+	if (!fMaster) fMessenger = new GarfieldPhysicsMessenger(this);
 }
 
 GarfieldPhysics::~GarfieldPhysics() {
 	delete fMapParticlesEnergy;
-	DeleteSecondaryElectrons();
-	delete fSecondaryElectrons;
-	delete fMediumMagboltz;
+	if (fMediumMagboltz) {
+		G4AutoLock lock(&garfieldMutex);
+		if (--sharedMediumUsers == 0) {
+			delete sharedMediumMagboltz;
+			sharedMediumMagboltz = 0;
+		}
+	}
 	delete fSensor;
 	delete fAvalalancheMicroscopic;
 	delete fComponentConstant;
 	delete fTrackHeed;
 	delete fTrackElectron;
-	delete fGeometryRoot;
+	delete fGeometrySimple;
+	delete fDriftBox;
+	delete fClusterLibrary;
+	delete fMessenger;
+	{
+		G4AutoLock lock(&garfieldMutex);
+		if (fMaster) {
+			std::vector<GarfieldPhysics*>& clones = fMaster->fClones;
+			clones.erase(std::remove(clones.begin(), clones.end(), this),
+					clones.end());
+		}
+		for (size_t i = 0; i < fClones.size(); i++) {
+			fClones[i]->fMaster = 0;
+		}
+	}
 
 	G4cout << "Deconstructor GarfieldPhysics" << G4endl;
 }
 
+GarfieldPhysics* GarfieldPhysics::Clone() {
+	GarfieldPhysics* clone = new GarfieldPhysics(fName, this);
+	clone->fMapParticlesEnergy->insert(fMapParticlesEnergy->begin(),
+			fMapParticlesEnergy->end());
+	clone->SetDriftVolume(fHalfX_cm, fHalfY_cm, fHalfZ_cm);
+	clone->fGasCacheDir = fGasCacheDir;
+	clone->fIonMobilityFile = fIonMobilityFile;
+	clone->fDriftElectrons = fDriftElectrons;
+	clone->fDriftField_Vcm = fDriftField_Vcm;
+	// After the drift volume and field, checked against the library
+	if (fClusterLibrary && fClusterLibrary->IsOpen()) {
+		clone->LoadClusterLibrary(fClusterLibrary->GetFileName());
+	}
+	clone->fUseClusterLibrary = fUseClusterLibrary;
+	if (!fUseClusterLibrary && !fMapParticlesEnergy->empty()) {
+		G4cout << "GarfieldPhysics: live Heed, the threads take turns in the"
+				<< " drift gap (/garfield/useClusterLibrary to scale)" << G4endl;
+	}
+
+	// The workers are built concurrently
+	G4AutoLock lock(&garfieldMutex);
+	fClones.push_back(clone);
+	return clone;
+}
+
+std::vector<GarfieldPhysics*> GarfieldPhysics::GetClones() const {
+	G4AutoLock lock(&garfieldMutex);
+	return fClones;
+}
+
+void GarfieldPhysics::SetUseClusterLibrary(bool val) {
+	fUseClusterLibrary = val;
+	std::vector<GarfieldPhysics*> clones = GetClones();
+	for (size_t i = 0; i < clones.size(); i++) {
+		clones[i]->SetUseClusterLibrary(val);
+	}
+}
+
+void GarfieldPhysics::SetGasCacheDir(const std::string& dir) {
+	fGasCacheDir = dir;
+	std::vector<GarfieldPhysics*> clones = GetClones();
+	for (size_t i = 0; i < clones.size(); i++) {
+		clones[i]->SetGasCacheDir(dir);
+	}
+}
+
+void GarfieldPhysics::SetIonMobilityFile(const std::string& file) {
+	fIonMobilityFile = file;
+	std::vector<GarfieldPhysics*> clones = GetClones();
+	for (size_t i = 0; i < clones.size(); i++) {
+		clones[i]->SetIonMobilityFile(file);
+	}
+}
+
 void GarfieldPhysics::AddParticleName(const std::string particleName,
 		double ekin_min_keV, double ekin_max_keV) {
 	if (ekin_min_keV >= ekin_max_keV) {
@@ -46,6 +142,42 @@ void GarfieldPhysics::AddParticleName(const std::string particleName,
 
 }
 
+bool GarfieldPhysics::AddParticleNames(const std::string& list) {
+	if (list == "none") return true;
+	std::istringstream entries(list);
+	std::string entry;
+	while (std::getline(entries, entry, ',')) {
+		std::string::size_type first = entry.find(':');
+		std::string::size_type second = entry.find(':', first + 1);
+		if (first == std::string::npos || second == std::string::npos) {
+			G4cerr << "GarfieldPhysics: particle \"" << entry
+					<< "\" is not name:min_keV:max_keV" << G4endl;
+			return false;
+		}
+		char* end1 = 0;
+		char* end2 = 0;
+		std::string min = entry.substr(first + 1, second - first - 1);
+		std::string max = entry.substr(second + 1);
+		double ekin_min_keV = strtod(min.c_str(), &end1);
+		double ekin_max_keV = strtod(max.c_str(), &end2);
+		if (first == 0 || min.empty() || max.empty() || *end1 != '\0'
+				|| *end2 != '\0') {
+			G4cerr << "GarfieldPhysics: particle \"" << entry
+					<< "\" is not name:min_keV:max_keV" << G4endl;
+			return false;
+		}
+		AddParticleName(entry.substr(0, first), ekin_min_keV, ekin_max_keV);
+	}
+	return true;
+}
+
+std::string GarfieldPhysics::DefaultParticleNames() {
+	if (getenv("NEUTRONGEM_GARFIELD_PARTICLES")) {
+		return getenv("NEUTRONGEM_GARFIELD_PARTICLES");
+	}
+	return "e-:0:10000,gamma:0:10000";
+}
+
 bool GarfieldPhysics::FindParticleName(std::string name) {
 	MapParticlesEnergy::iterator it;
 	it = fMapParticlesEnergy->find(name);
@@ -69,28 +201,20 @@ bool GarfieldPhysics::FindParticleNameEnergy(std::string name,
 }
 
 void GarfieldPhysics::InitializePhysics() {
+	G4AutoLock lock(&garfieldMutex);
 
-	fMediumMagboltz = new Garfield::MediumMagboltz();
+	if (!sharedMediumMagboltz) {
+		sharedMediumMagboltz = GarfieldGas::Create(fGasCacheDir,
+				fIonMobilityFile, G4cout);
+	}
+	++sharedMediumUsers;
+	fMediumMagboltz = sharedMediumMagboltz;
 	fSensor = new Garfield::Sensor();
 	fAvalalancheMicroscopic = new Garfield::AvalancheMicroscopic();
 
-	fMediumMagboltz->SetComposition("ar", 70., "co2", 30.);
-	fMediumMagboltz->SetTemperature(293.15);
-	fMediumMagboltz->SetPressure(760.);
-	fMediumMagboltz->EnableDebugging();
-	fMediumMagboltz->Initialise(true);
-	fMediumMagboltz->DisableDebugging();
-
-	// Set the Penning transfer efficiency.
-	const double rPenning = 0.57;
-	const double lambdaPenning = 0.;
-	fMediumMagboltz->EnablePenningTransfer(rPenning, lambdaPenning, "ar");
-	// Load the ion mobilities.
-	fMediumMagboltz->LoadIonMobility(
-			"/afs/cern.ch/user/d/dpfeiffe/garfield/Data/IonMobility_Ar+_Ar.txt");
-
 	fComponentConstant = new Garfield::ComponentConstant();
-	fComponentConstant->SetElectricField(0, 0, 1000);
+	// Same direction as the G4UniformElectricField of the detector
+	fComponentConstant->SetElectricField(0, 0, -fDriftField_Vcm);
 
 	fTrackHeed = new Garfield::TrackHeed();
 	fTrackHeed->SetSensor(fSensor);
@@ -98,37 +222,90 @@ void GarfieldPhysics::InitializePhysics() {
 	fTrackElectron = new Garfield::TrackElectron();
 	fTrackElectron->SetSensor(fSensor);
 
-	CreateGeometryFromGDML("drift.gdml", "ArCO2");
+	CreateGeometry();
+	InitializeDrift();
+
+}
+
+bool GarfieldPhysics::IsGasCreated() {
+	G4AutoLock lock(&garfieldMutex);
+	return sharedMediumMagboltz != 0;
+}
+
+void GarfieldPhysics::InitializeDrift() {
+	// Computed even with the drift off, /garfield/driftElectrons can
+	// switch it on later. fDriftVelocity stays 0 if there is no drift.
+	fDriftVelocity = 0;
+	if (fDriftField_Vcm <= 0) {
+		G4cout << "GarfieldPhysics: no drift field in the detector,"
+				<< " electrons not drifted" << G4endl;
+		fDriftElectrons = false;
+		return;
+	}
+	// Interpolated in the gas tables: no magnetic field, the field along -z
+	double vx = 0., vy = 0., vz = 0.;
+	if (!fMediumMagboltz->ElectronVelocity(0, 0, -fDriftField_Vcm, 0, 0, 0, vx,
+			vy, vz)
+			|| !fMediumMagboltz->ElectronDiffusion(0, 0, -fDriftField_Vcm, 0, 0,
+					0, fDiffusionL, fDiffusionT)
+			|| !fMediumMagboltz->ElectronAttachment(0, 0, -fDriftField_Vcm, 0,
+					0, 0, fAttachment)) {
+		G4cerr << "GarfieldPhysics: no gas transport parameters at "
+				<< fDriftField_Vcm << " V/cm, electrons not drifted" << G4endl;
+		fDriftElectrons = false;
+		return;
+	}
+	const double velocity = std::sqrt(vx * vx + vy * vy + vz * vz);
+	if (!(velocity > 0) || vz <= 0) {
+		G4cerr << "GarfieldPhysics: no electron drift to +z at "
+				<< fDriftField_Vcm << " V/cm, electrons not drifted" << G4endl;
+		fDriftElectrons = false;
+		return;
+	}
+	fDriftVelocity = velocity;
+	if (fAttachment < 0) fAttachment = 0;
+	G4cout << "\nDrift at " << fDriftField_Vcm << " V/cm: v="
+			<< fDriftVelocity * 1000 << " cm/us, DL=" << fDiffusionL
+			<< " sqrt(cm), DT=" << fDiffusionT << " sqrt(cm), eta="
+			<< fAttachment << " 1/cm" << G4endl;
+}
+
+void GarfieldPhysics::SetDriftElectrons(bool val) {
+	// Before InitializePhysics() the gas is not known yet: InitializeDrift() checks
+	if (val && fMediumMagboltz && fDriftVelocity <= 0) {
+		G4cerr << "GarfieldPhysics: no drift velocity (see the drift field),"
+				<< " electrons not drifted" << G4endl;
+		val = false;
+	}
+	fDriftElectrons = val;
+	std::vector<GarfieldPhysics*> clones = GetClones();
+	for (size_t i = 0; i < clones.size(); i++) {
+		clones[i]->SetDriftElectrons(val);
+	}
+}
 
+void GarfieldPhysics::SetDriftVolume(double halfX_cm, double halfY_cm,
+		double halfZ_cm) {
+	fHalfX_cm = halfX_cm;
+	fHalfY_cm = halfY_cm;
+	fHalfZ_cm = halfZ_cm;
 }
 
-void GarfieldPhysics::CreateGeometryFromGDML(std::string geometryFile,
-		std::string gasMedium) {
-	fGeoManager = new TGeoManager("world", "geometry");
-	TGDMLParse gdmlparser;
-	TGeoVolume *top = new TGeoVolume();
-	G4String file = "./" + geometryFile;
-	top = gdmlparser.GDMLReadFile(file.c_str());
-	TGeoBBox* box = (TGeoBBox*) top->GetShape();
-	double dx, dy, dz;
-	dx = box->GetDX();
-	dy = box->GetDY();
-	dz = box->GetDZ();
-	fGeoManager->SetTopVolume(top);
-	fGeoManager->CloseGeometry();
-
-	TGeoMaterial* material = top->GetMaterial();
-	material->Print();
-
-	fGeometryRoot = new Garfield::GeometryRoot();
-	fGeometryRoot->SetGeometry(fGeoManager);
-	fGeometryRoot->SetMedium(gasMedium.c_str(), fMediumMagboltz);
-
-	fSensor->SetArea(-dx, -dy, -dz, dx, dy, dz);
-	G4cout << "\nArea of drift: " << "dx=" << dx << "cm, dy=" << dy << "cm, dz="
-			<< dz << "cm" << G4endl;
+void GarfieldPhysics::CreateGeometry() {
+	if (fHalfX_cm <= 0 || fHalfY_cm <= 0 || fHalfZ_cm <= 0) {
+		G4cerr << "GarfieldPhysics: drift volume not set" << G4endl;
+	}
+	fDriftBox = new Garfield::SolidBox(0., 0., 0., fHalfX_cm, fHalfY_cm,
+			fHalfZ_cm);
+	fGeometrySimple = new Garfield::GeometrySimple();
+	fGeometrySimple->AddSolid(fDriftBox, fMediumMagboltz);
+
+	fSensor->SetArea(-fHalfX_cm, -fHalfY_cm, -fHalfZ_cm, fHalfX_cm, fHalfY_cm,
+			fHalfZ_cm);
+	G4cout << "\nArea of drift: " << "dx=" << fHalfX_cm << "cm, dy="
+			<< fHalfY_cm << "cm, dz=" << fHalfZ_cm << "cm" << G4endl;
 	fAvalalancheMicroscopic->SetSensor(fSensor);
-	fComponentConstant->SetGeometry(fGeometryRoot);
+	fComponentConstant->SetGeometry(fGeometrySimple);
 	fSensor->AddComponent(fComponentConstant);
 }
 
@@ -137,7 +314,16 @@ void GarfieldPhysics::DoIt(std::string particleName, double ekin_keV,double time
 		double dz, bool createSecondaries) {
 
 
-	DeleteSecondaryElectrons();
+	fSecondaryElectrons.Clear();
+
+	if (fUseClusterLibrary
+			&& DoItFromLibrary(particleName, ekin_keV, time, x_cm, y_cm, z_cm,
+					dx, dy, dz, createSecondaries)) {
+		DriftElectrons();
+		return;
+	}
+	// Heed has global state, shared by all the threads
+	G4AutoLock lock(&garfieldMutex);
 
 	NeutronGEMDataManager* dataManager = NeutronGEMDataManager::GetInstance();
 	NeutronGEMHistoManager* histoManager = dataManager->getHistoManager();
@@ -186,8 +372,9 @@ void GarfieldPhysics::DoIt(std::string particleName, double ekin_keV,double time
 							dze);
 					if(createSecondaries)
 					{
-						fSecondaryElectrons->push_back(new GarfieldElectron(xe, ye, ze, ee, te, dxe, dye,dze));
+						AddSecondaryElectron(xe, ye, ze, te, ee, dxe, dye, dze);
 					}
+					AddDriftElectron(xe, ye, ze, te);
 					histoManager->Fill3DEnergyElectrons(1,xe,ye,ze,ee);
 					//G4cout << "       e-: x=" << xe << "cm, y=" << ye << "cm, z=" << ze << "cm, E=" << ee << "eV" << G4endl;
 					dataManager->increaseCounter(11);
@@ -216,6 +403,7 @@ void GarfieldPhysics::DoIt(std::string particleName, double ekin_keV,double time
 				nsum += nc;
 				histoManager->Fill3DEnergyElectrons(1,xc,yc,zc,ec);
 				for (int i = 0; i < nc; ++i) {
+					AddDriftElectron(xc, yc, zc, tc);
 					dataManager->increaseCounter(11);
 					histoManager->AddClustersConversionElectrons();
 				}
@@ -235,8 +423,9 @@ void GarfieldPhysics::DoIt(std::string particleName, double ekin_keV,double time
 			//std::cout << "Ekin=" << ee << std::endl;
 			if(createSecondaries)
 			{
-				fSecondaryElectrons->push_back(new GarfieldElectron(xe, ye, ze, ee, te,dxe, dye,dze));
+				AddSecondaryElectron(xe, ye, ze, te, ee, dxe, dye, dze);
 			}
+			AddDriftElectron(xe, ye, ze, te);
 			histoManager->Fill3DEnergyElectrons(4,xe,ye,ze,ee);
 			esum += ee;
 			//G4cout << "       e-: x=" << xe << "cm, y=" << ye << "cm, z=" << ze << "cm, E=" << ee << "eV" << G4endl;
@@ -247,6 +436,7 @@ void GarfieldPhysics::DoIt(std::string particleName, double ekin_keV,double time
 		histoManager->fillHistogram(24, (double)(esum*0.001));
 
 	}
+	DriftElectrons();
 	/*
 	if (nsum > 0) {
 		G4cout << "In drift: " << ekin_keV << " keV " << particleName << G4endl;
@@ -258,17 +448,191 @@ void GarfieldPhysics::DoIt(std::string particleName, double ekin_keV,double time
 }
 
 
-std::vector<GarfieldElectron*>* GarfieldPhysics::GetSecondaryElectrons()
-{
-	return fSecondaryElectrons;
+bool GarfieldPhysics::DoItFromLibrary(const std::string& particleName,
+		double ekin_keV, double time, double x_cm, double y_cm, double z_cm,
+		double dx, double dy, double dz, bool createSecondaries) {
+	if (!fClusterLibrary || !fClusterLibrary->IsOpen()) return false;
+	HeedClusterLibrary::Particle particle;
+	if (particleName == "e-" || particleName == "electron") {
+		particle = HeedClusterLibrary::kElectron;
+	} else if (particleName == "gamma") {
+		particle = HeedClusterLibrary::kGamma;
+	} else {
+		return false;
+	}
+	// The cosine is taken with the drift axis (z)
+	int bin = fClusterLibrary->GetBin(particle, ekin_keV, dz, G4UniformRand());
+	if (bin < 0) return false;
+	const HeedClusterLibrary::Track& track = fClusterLibrary->SampleTrack(bin,
+			G4UniformRand());
+
+	// Axes of the library track: the direction and a frame rotated
+	// by a random angle around it
+	double d[3] = { dx, dy, dz };
+	double v0[3], w0[3], v[3], w[3];
+	HeedClusterLibrary::Frame(d, v0, w0);
+	double phi = CLHEP::twopi * G4UniformRand();
+	double c = std::cos(phi), s = std::sin(phi);
+	for (int k = 0; k < 3; ++k) {
+		v[k] = c * v0[k] + s * w0[k];
+		w[k] = -s * v0[k] + c * w0[k];
+	}
+
+	NeutronGEMDataManager* dataManager = NeutronGEMDataManager::GetInstance();
+	NeutronGEMHistoManager* histoManager = dataManager->getHistoManager();
+
+	// Same counters and histograms as the Heed transport in DoIt
+	double esum = 0.;
+	const HeedClusterLibrary::Cluster* clusters = fClusterLibrary->GetClusters(
+			track);
+	for (uint32_t ic = 0; ic < track.nClusters; ++ic) {
+		const HeedClusterLibrary::Cluster& cluster = clusters[ic];
+		double xc = x_cm + cluster.u * d[0] + cluster.v * v[0] + cluster.w * w[0];
+		double yc = y_cm + cluster.u * d[1] + cluster.v * v[1] + cluster.w * w[1];
+		double zc = z_cm + cluster.u * d[2] + cluster.v * v[2] + cluster.w * w[2];
+		// The library tracks are generated in unbounded gas:
+		// an electron stops where it leaves the drift gap
+		if (particle == HeedClusterLibrary::kElectron && !InDrift(xc, yc, zc)) {
+			break;
+		}
+		if (particle == HeedClusterLibrary::kElectron) {
+			esum += cluster.energy;
+		}
+		if (cluster.nStored == 0) {
+			// TrackElectron cluster: no single electrons
+			histoManager->Fill3DEnergyElectrons(1, xc, yc, zc, cluster.energy);
+			for (uint32_t i = 0; i < cluster.nElectrons; ++i) {
+				AddDriftElectron(xc, yc, zc, time + cluster.t);
+				dataManager->increaseCounter(11);
+				histoManager->AddClustersConversionElectrons();
+			}
+		}
+		const HeedClusterLibrary::Electron* electrons =
+				fClusterLibrary->GetElectrons(cluster);
+		for (uint32_t i = 0; i < cluster.nStored; ++i) {
+			const HeedClusterLibrary::Electron& e = electrons[i];
+			double xe = x_cm + e.u * d[0] + e.v * v[0] + e.w * w[0];
+			double ye = y_cm + e.u * d[1] + e.v * v[1] + e.w * w[1];
+			double ze = z_cm + e.u * d[2] + e.v * v[2] + e.w * w[2];
+			// Photons convert anywhere along their path: the electrons
+			// outside the drift gap are not seen
+			if (particle == HeedClusterLibrary::kGamma && !InDrift(xe, ye, ze)) {
+				continue;
+			}
+			if (createSecondaries) {
+				AddSecondaryElectron(xe, ye, ze, time + e.t, e.energy,
+						e.du * d[0] + e.dv * v[0] + e.dw * w[0],
+						e.du * d[1] + e.dv * v[1] + e.dw * w[1],
+						e.du * d[2] + e.dv * v[2] + e.dw * w[2]);
+			}
+			AddDriftElectron(xe, ye, ze, time + e.t);
+			if (particle == HeedClusterLibrary::kGamma) {
+				histoManager->Fill3DEnergyElectrons(4, xe, ye, ze, e.energy);
+				esum += e.energy;
+				dataManager->increaseCounter(14);
+				histoManager->AddClustersGammas();
+			} else {
+				histoManager->Fill3DEnergyElectrons(1, xe, ye, ze, e.energy);
+				dataManager->increaseCounter(11);
+				histoManager->AddClustersConversionElectrons();
+			}
+		}
+		if (particle == HeedClusterLibrary::kElectron) {
+			histoManager->fillHistogram(21, (double) (esum * 0.001));
+		}
+	}
+	if (particle == HeedClusterLibrary::kGamma) {
+		histoManager->fillHistogram(24, (double) (esum * 0.001));
+	}
+	return true;
 }
 
+void GarfieldPhysics::AddSecondaryElectron(double x_cm, double y_cm,
+		double z_cm, double time, double ekin_eV, double dx, double dy,
+		double dz) {
+	fSecondaryElectrons.Add(ekin_eV, time, x_cm, y_cm, z_cm, dx, dy, dz);
+}
 
-void GarfieldPhysics::DeleteSecondaryElectrons()
-{
-	if(! fSecondaryElectrons->empty())
-	{
-		fSecondaryElectrons->erase(fSecondaryElectrons->begin(), fSecondaryElectrons->end());
+void GarfieldPhysics::DriftElectrons() {
+	const size_t n = fDriftX.size();
+	// AddDriftElectron() stores nothing without a drift velocity
+	if (n == 0 || fDriftVelocity <= 0) return;
+
+	fDriftSigmaT.resize(n);
+	fDriftSigmaTime.resize(n);
+	fDriftSurvival.resize(n);
+	fGauss.resize(3 * n);
+	fFlat.resize(n);
+	double* x = &fDriftX[0];
+	double* y = &fDriftY[0];
+	double* z = &fDriftZ[0];
+	double* t = &fDriftT[0];
+	double* sigmaT = &fDriftSigmaT[0];
+	double* sigmaTime = &fDriftSigmaTime[0];
+	double* survival = &fDriftSurvival[0];
+
+	// Mean arrival time, spreads and survival: no branches, the loop
+	// over the arrays can be vectorised by the compiler
+	const double invVelocity = 1. / fDriftVelocity;
+	for (size_t i = 0; i < n; ++i) {
+		const double length = std::max(fHalfZ_cm - z[i], 0.);
+		const double sqrtLength = std::sqrt(length);
+		t[i] += length * invVelocity;
+		sigmaT[i] = fDiffusionT * sqrtLength;
+		sigmaTime[i] = fDiffusionL * sqrtLength * invVelocity;
+		survival[i] = std::exp(-fAttachment * length);
+	}
+
+	G4RandGauss::shootArray((int) (3 * n), &fGauss[0]);
+	CLHEP::RandFlat::shootArray((int) n, &fFlat[0]);
+
+	NeutronGEMHistoManager* histoManager =
+			NeutronGEMDataManager::GetInstance()->getHistoManager();
+	const double* gauss = &fGauss[0];
+	for (size_t i = 0; i < n; ++i) {
+		// Attached on the way
+		if (fFlat[i] >= survival[i]) continue;
+		histoManager->FillReadout(x[i] + sigmaT[i] * gauss[3 * i],
+				y[i] + sigmaT[i] * gauss[3 * i + 1],
+				t[i] + sigmaTime[i] * gauss[3 * i + 2]);
 	}
+
+	fDriftX.clear();
+	fDriftY.clear();
+	fDriftZ.clear();
+	fDriftT.clear();
 }
 
+bool GarfieldPhysics::LoadClusterLibrary(const std::string& fileName) {
+	std::vector<GarfieldPhysics*> clones = GetClones();
+	for (size_t i = 0; i < clones.size(); i++) {
+		clones[i]->LoadClusterLibrary(fileName);
+	}
+	if (!fClusterLibrary) fClusterLibrary = new HeedClusterLibrary();
+	if (!fClusterLibrary->Open(fileName)) return false;
+	// The library must describe the gas and the field of this simulation
+	const std::string gasName = GarfieldGas::GetName();
+	const double libraryField = fClusterLibrary->GetDriftField();
+	const double libraryHalfSize = fClusterLibrary->GetHalfSize();
+	std::string mismatch;
+	if (fClusterLibrary->GetGasName() != gasName) {
+		mismatch = "gas " + fClusterLibrary->GetGasName() + " instead of "
+				+ gasName;
+	} else if (std::fabs(libraryField - fDriftField_Vcm)
+			> 1.e-3 * std::max(std::fabs(fDriftField_Vcm), 1.)) {
+		std::ostringstream text;
+		text << "drift field " << libraryField << " V/cm instead of "
+				<< fDriftField_Vcm << " V/cm";
+		mismatch = text.str();
+	} else if (fHalfX_cm > libraryHalfSize || fHalfY_cm > libraryHalfSize
+			|| fHalfZ_cm > libraryHalfSize) {
+		mismatch = "gas box smaller than the drift gap";
+	}
+	if (!mismatch.empty()) {
+		G4cerr << "GarfieldPhysics: " << fileName << " made with "
+				<< mismatch << ", run buildHeedLibrary again" << G4endl;
+		fClusterLibrary->Close();
+		return false;
+	}
+	return true;
+}
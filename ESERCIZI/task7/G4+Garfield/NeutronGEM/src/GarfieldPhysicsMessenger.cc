@@ -0,0 +1,91 @@
+/// \file GarfieldPhysicsMessenger.cc
+/// \brief Implementation of the GarfieldPhysicsMessenger class
+
+#include "GarfieldPhysicsMessenger.hh"
+#include "GarfieldPhysics.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+
+GarfieldPhysicsMessenger::GarfieldPhysicsMessenger(
+		GarfieldPhysics* garfieldPhysics) :
+		fGarfieldPhysics(garfieldPhysics) {
+	// Only in the master thread: GarfieldPhysics forwards to the worker clones
+	fGarfieldDir = new G4UIdirectory("/garfield/", false);
+	fGarfieldDir->SetGuidance("Garfield transport in the drift gap");
+
+	fLibraryCmd = new G4UIcmdWithAString("/garfield/clusterLibrary", this);
+	fLibraryCmd->SetGuidance("Load a Heed cluster library (made with buildHeedLibrary).");
+	fLibraryCmd->SetGuidance("Refused if made for another gas, drift field or drift gap.");
+	fLibraryCmd->SetGuidance("It is used only after /garfield/useClusterLibrary true.");
+	fLibraryCmd->SetParameterName("file", false);
+	fLibraryCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	fUseLibraryCmd = new G4UIcmdWithABool("/garfield/useClusterLibrary", this);
+	fUseLibraryCmd->SetGuidance("Clusters from the library (true) or from Heed (false, default).");
+	fUseLibraryCmd->SetGuidance("Check the library against Heed first: run/validate_heed_library.sh");
+	fUseLibraryCmd->SetGuidance("Outside the library energy range Heed is always used.");
+	fUseLibraryCmd->SetGuidance("Live Heed runs in one thread at a time: with more threads");
+	fUseLibraryCmd->SetGuidance("only the library speeds up the transport in the drift gap.");
+	fUseLibraryCmd->SetParameterName("use", false);
+	fUseLibraryCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	fGasCacheCmd = new G4UIcmdWithAString("/garfield/gasCacheDir", this);
+	fGasCacheCmd->SetGuidance("Directory of the Magboltz gas tables (.gas files).");
+	fGasCacheCmd->SetGuidance("The tables are computed once and then read from there.");
+	fGasCacheCmd->SetGuidance("No effect once the gas is created: in a sequential run");
+	fGasCacheCmd->SetGuidance("main() does it before the macro, set NEUTRONGEM_GAS_CACHE.");
+	fGasCacheCmd->SetParameterName("dir", false);
+	fGasCacheCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	fIonMobilityCmd = new G4UIcmdWithAString("/garfield/ionMobility", this);
+	fIonMobilityCmd->SetGuidance("Ion mobility file of the gas.");
+	fIonMobilityCmd->SetGuidance("No effect once the gas is created: in a sequential run");
+	fIonMobilityCmd->SetGuidance("main() does it before the macro, set NEUTRONGEM_ION_MOBILITY.");
+	fIonMobilityCmd->SetParameterName("file", false);
+	fIonMobilityCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	fDriftCmd = new G4UIcmdWithABool("/garfield/driftElectrons", this);
+	fDriftCmd->SetGuidance("Drift the ionisation electrons to the readout plane");
+	fDriftCmd->SetGuidance("with the drift velocity, diffusion and attachment");
+	fDriftCmd->SetGuidance("of the gas tables (parameterised, no avalanche).");
+	fDriftCmd->SetParameterName("drift", false);
+	fDriftCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GarfieldPhysicsMessenger::~GarfieldPhysicsMessenger() {
+	delete fDriftCmd;
+	delete fIonMobilityCmd;
+	delete fGasCacheCmd;
+	delete fUseLibraryCmd;
+	delete fLibraryCmd;
+	delete fGarfieldDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GarfieldPhysicsMessenger::SetNewValue(G4UIcommand* command,
+		G4String newValue) {
+	if (command == fLibraryCmd) {
+		if (!fGarfieldPhysics->LoadClusterLibrary(newValue))
+			G4cerr << "Heed cluster library not loaded, Heed is used" << G4endl;
+	} else if (command == fUseLibraryCmd) {
+		fGarfieldPhysics->SetUseClusterLibrary(
+				fUseLibraryCmd->GetNewBoolValue(newValue));
+	} else if (command == fGasCacheCmd) {
+		if (GarfieldPhysics::IsGasCreated())
+			G4cerr << "Gas already created, /garfield/gasCacheDir ignored:"
+					<< " set NEUTRONGEM_GAS_CACHE before starting" << G4endl;
+		fGarfieldPhysics->SetGasCacheDir(newValue);
+	} else if (command == fIonMobilityCmd) {
+		if (GarfieldPhysics::IsGasCreated())
+			G4cerr << "Gas already created, /garfield/ionMobility ignored:"
+					<< " set NEUTRONGEM_ION_MOBILITY before starting" << G4endl;
+		fGarfieldPhysics->SetIonMobilityFile(newValue);
+	} else if (command == fDriftCmd) {
+		fGarfieldPhysics->SetDriftElectrons(fDriftCmd->GetNewBoolValue(newValue));
+	}
+}
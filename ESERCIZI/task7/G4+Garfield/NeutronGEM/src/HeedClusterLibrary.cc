@@ -0,0 +1,266 @@
+/*
+ * HeedClusterLibrary.cc
+ *
+ *  Pre-generated Heed clusters in the drift gas
+ */
+
+#include "HeedClusterLibrary.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+	const char libraryMagic[8] = "HEEDLIB";
+	const uint32_t libraryVersion = 2;
+
+	//! Order of the tracks when writing: by bin, then as added
+	struct ByBin {
+		ByBin(const std::vector<uint32_t>& bins) : fBins(bins) {}
+		bool operator()(size_t a, size_t b) const {
+			return fBins[a] < fBins[b] || (fBins[a] == fBins[b] && a < b);
+		}
+		const std::vector<uint32_t>& fBins;
+	};
+}
+
+HeedClusterLibrary::HeedClusterLibrary() :
+		fMap(0), fMapSize(0), fHeader(0), fBins(0), fTracks(0), fClusters(0),
+		fElectrons(0) {
+}
+
+HeedClusterLibrary::~HeedClusterLibrary() {
+	Close();
+}
+
+bool HeedClusterLibrary::Open(const std::string& fileName) {
+	Close();
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0) {
+		std::cerr << "HeedClusterLibrary: cannot open " << fileName << std::endl;
+		return false;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size < (off_t) sizeof(Header)) {
+		std::cerr << "HeedClusterLibrary: " << fileName << " is not a library"
+				<< std::endl;
+		close(fd);
+		return false;
+	}
+	void* map = mmap(0, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		std::cerr << "HeedClusterLibrary: cannot map " << fileName << std::endl;
+		return false;
+	}
+
+	const Header* header = static_cast<const Header*>(map);
+	size_t expected = sizeof(Header) + header->nBins * sizeof(Bin)
+			+ header->nTracks * sizeof(Track)
+			+ header->nClusters * sizeof(Cluster)
+			+ header->nElectrons * sizeof(Electron);
+	if (std::memcmp(header->magic, libraryMagic, sizeof(libraryMagic)) != 0
+			|| header->version != libraryVersion
+			|| header->nBins != BinIndex(*header, kNumberOfParticles, 0, 0)
+			|| std::memchr(header->gas, 0, sizeof(header->gas)) == 0
+			|| (size_t) info.st_size != expected) {
+		std::cerr << "HeedClusterLibrary: wrong format or version of "
+				<< fileName << std::endl;
+		munmap(map, info.st_size);
+		return false;
+	}
+
+	fMap = map;
+	fMapSize = info.st_size;
+	fFileName = fileName;
+	fHeader = header;
+	fBins = reinterpret_cast<const Bin*>(fHeader + 1);
+	fTracks = reinterpret_cast<const Track*>(fBins + fHeader->nBins);
+	fClusters = reinterpret_cast<const Cluster*>(fTracks + fHeader->nTracks);
+	fElectrons = reinterpret_cast<const Electron*>(fClusters
+			+ fHeader->nClusters);
+	std::cout << "HeedClusterLibrary: " << fHeader->nTracks << " tracks, "
+			<< fHeader->nClusters << " clusters from " << fileName << std::endl;
+	return true;
+}
+
+void HeedClusterLibrary::Close() {
+	if (fMap) munmap(fMap, fMapSize);
+	fMap = 0;
+	fMapSize = 0;
+	fHeader = 0;
+	fBins = 0;
+	fTracks = 0;
+	fClusters = 0;
+	fElectrons = 0;
+	fFileName.clear();
+}
+
+int HeedClusterLibrary::GetBin(Particle particle, double ekin_keV,
+		double cosine, double random) const {
+	if (!fHeader || ekin_keV <= 0) return -1;
+	double logE = std::log10(ekin_keV);
+	if (logE < fHeader->log10EminKeV || logE > fHeader->log10EmaxKeV) return -1;
+
+	unsigned int ie = 0;
+	if (fHeader->nEnergies > 1) {
+		double x = (logE - fHeader->log10EminKeV)
+				/ (fHeader->log10EmaxKeV - fHeader->log10EminKeV)
+				* (fHeader->nEnergies - 1);
+		ie = std::min((unsigned int) x, fHeader->nEnergies - 1);
+		if (ie + 1 < fHeader->nEnergies && random < x - ie) ++ie;
+	}
+	int ic = (int) ((cosine + 1) / 2 * fHeader->nCosines);
+	ic = std::max(0, std::min(ic, (int) fHeader->nCosines - 1));
+
+	unsigned int bin = BinIndex(*fHeader, particle, ie, ic);
+	return fBins[bin].nTracks > 0 ? (int) bin : -1;
+}
+
+const HeedClusterLibrary::Track& HeedClusterLibrary::SampleTrack(int bin,
+		double random) const {
+	const Bin& theBin = fBins[bin];
+	uint32_t i = std::min((uint32_t) (random * theBin.nTracks),
+			theBin.nTracks - 1);
+	return fTracks[theBin.firstTrack + i];
+}
+
+void HeedClusterLibrary::Frame(const double d[3], double v[3], double w[3]) {
+	// v: orthogonal to d in the plane of d and the axis least aligned with d
+	double a[3] = { 0., 0., 0. };
+	if (std::fabs(d[0]) < std::fabs(d[1]) && std::fabs(d[0]) < std::fabs(d[2]))
+		a[0] = 1;
+	else if (std::fabs(d[1]) < std::fabs(d[2]))
+		a[1] = 1;
+	else
+		a[2] = 1;
+	v[0] = a[1] * d[2] - a[2] * d[1];
+	v[1] = a[2] * d[0] - a[0] * d[2];
+	v[2] = a[0] * d[1] - a[1] * d[0];
+	double norm = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+	for (int k = 0; k < 3; ++k) v[k] /= norm;
+	w[0] = d[1] * v[2] - d[2] * v[1];
+	w[1] = d[2] * v[0] - d[0] * v[2];
+	w[2] = d[0] * v[1] - d[1] * v[0];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+HeedClusterLibrary::Builder::Builder(unsigned int nEnergies, double eminKeV,
+		double emaxKeV, unsigned int nCosines) {
+	std::memset(&fHeader, 0, sizeof(fHeader));
+	std::memcpy(fHeader.magic, libraryMagic, sizeof(libraryMagic));
+	fHeader.version = libraryVersion;
+	fHeader.nEnergies = std::max(nEnergies, 1u);
+	fHeader.nCosines = std::max(nCosines, 1u);
+	fHeader.log10EminKeV = std::log10(eminKeV);
+	fHeader.log10EmaxKeV = std::log10(emaxKeV);
+	fHeader.nBins = BinIndex(fHeader, kNumberOfParticles, 0, 0);
+}
+
+double HeedClusterLibrary::Builder::GetEnergy(unsigned int ie) const {
+	if (fHeader.nEnergies == 1) return std::pow(10., fHeader.log10EminKeV);
+	return std::pow(10., fHeader.log10EminKeV + ie
+			* (fHeader.log10EmaxKeV - fHeader.log10EminKeV)
+			/ (fHeader.nEnergies - 1));
+}
+
+void HeedClusterLibrary::Builder::GetCosineRange(unsigned int ic, double& low,
+		double& high) const {
+	low = -1 + 2. * ic / fHeader.nCosines;
+	high = -1 + 2. * (ic + 1) / fHeader.nCosines;
+}
+
+void HeedClusterLibrary::Builder::BeginTrack(Particle particle,
+		unsigned int ie, unsigned int ic) {
+	fTrackBin.push_back(BinIndex(fHeader, particle, ie, ic));
+	Track track;
+	track.firstCluster = fClusters.size();
+	track.nClusters = 0;
+	fTracks.push_back(track);
+}
+
+void HeedClusterLibrary::Builder::AddCluster(const Cluster& cluster) {
+	Cluster c = cluster;
+	c.firstElectron = fElectrons.size();
+	c.nStored = 0;
+	fClusters.push_back(c);
+	++fTracks.back().nClusters;
+}
+
+void HeedClusterLibrary::Builder::SetConditions(const std::string& gasName,
+		double driftField_Vcm, double halfSize_cm) {
+	std::memset(fHeader.gas, 0, sizeof(fHeader.gas));
+	gasName.copy(fHeader.gas, sizeof(fHeader.gas) - 1);
+	fHeader.driftField_Vcm = driftField_Vcm;
+	fHeader.halfSize_cm = halfSize_cm;
+}
+
+void HeedClusterLibrary::Builder::AddElectron(const Electron& electron) {
+	fElectrons.push_back(electron);
+	++fClusters.back().nStored;
+}
+
+bool HeedClusterLibrary::Builder::Write(const std::string& fileName) const {
+	std::vector<size_t> order(fTracks.size());
+	for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+	std::sort(order.begin(), order.end(), ByBin(fTrackBin));
+
+	// Tracks, clusters and electrons in the order of the bins
+	Header header = fHeader;
+	std::vector<Bin> bins(header.nBins);
+	for (size_t b = 0; b < bins.size(); ++b) {
+		bins[b].firstTrack = 0;
+		bins[b].nTracks = 0;
+	}
+	std::vector<Track> tracks;
+	std::vector<Cluster> clusters;
+	std::vector<Electron> electrons;
+	tracks.reserve(fTracks.size());
+	clusters.reserve(fClusters.size());
+	electrons.reserve(fElectrons.size());
+	for (size_t i = 0; i < order.size(); ++i) {
+		const Track& track = fTracks[order[i]];
+		Bin& bin = bins[fTrackBin[order[i]]];
+		if (bin.nTracks == 0) bin.firstTrack = tracks.size();
+		++bin.nTracks;
+		Track t;
+		t.firstCluster = clusters.size();
+		t.nClusters = track.nClusters;
+		tracks.push_back(t);
+		for (uint32_t c = 0; c < track.nClusters; ++c) {
+			Cluster cluster = fClusters[track.firstCluster + c];
+			uint32_t first = cluster.firstElectron;
+			cluster.firstElectron = electrons.size();
+			electrons.insert(electrons.end(), fElectrons.begin() + first,
+					fElectrons.begin() + first + cluster.nStored);
+			clusters.push_back(cluster);
+		}
+	}
+	header.nTracks = tracks.size();
+	header.nClusters = clusters.size();
+	header.nElectrons = electrons.size();
+
+	std::ofstream out(fileName.c_str(), std::ios::binary);
+	if (!out) {
+		std::cerr << "HeedClusterLibrary: cannot write " << fileName << std::endl;
+		return false;
+	}
+	out.write((const char*) &header, sizeof(header));
+	if (!bins.empty())
+		out.write((const char*) &bins[0], bins.size() * sizeof(Bin));
+	if (!tracks.empty())
+		out.write((const char*) &tracks[0], tracks.size() * sizeof(Track));
+	if (!clusters.empty())
+		out.write((const char*) &clusters[0], clusters.size() * sizeof(Cluster));
+	if (!electrons.empty())
+		out.write((const char*) &electrons[0],
+				electrons.size() * sizeof(Electron));
+	return out.good();
+}
@@ -0,0 +1,69 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// $Id$
+//
+/// \file NeutronGEMActionInitialization.cc
+/// \brief Implementation of the NeutronGEMActionInitialization class
+
+#include "NeutronGEMActionInitialization.hh"
+#include "NeutronGEMPrimaryGeneratorAction.hh"
+#include "NeutronGEMRunAction.hh"
+#include "NeutronGEMEventAction.hh"
+#include "NeutronGEMStackingAction.hh"
+#include "NeutronGEMSteppingAction.hh"
+#include "NeutronGEMTrackingAction.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+NeutronGEMActionInitialization::NeutronGEMActionInitialization()
+ : G4VUserActionInitialization()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+NeutronGEMActionInitialization::~NeutronGEMActionInitialization()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void NeutronGEMActionInitialization::BuildForMaster() const
+{
+	SetUserAction(new NeutronGEMRunAction);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void NeutronGEMActionInitialization::Build() const
+{
+	SetUserAction(new NeutronGEMPrimaryGeneratorAction);
+	SetUserAction(new NeutronGEMRunAction);
+	SetUserAction(new NeutronGEMEventAction);
+	SetUserAction(new NeutronGEMStackingAction);
+	SetUserAction(new NeutronGEMSteppingAction);
+	SetUserAction(new NeutronGEMTrackingAction);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -1,32 +1,62 @@
 #include "NeutronGEMDataManager.hh"
 #include "NeutronGEMHistoManager.hh"
+#include "G4Threading.hh"
 
 NeutronGEMDataManager::NeutronGEMDataManager() :
-		fNumberOfEvents(0), fHistoManager(NULL) {
+		fNumberOfEvents(0), fHistoManager(NULL), fPrimariesInEvent(0),
+		fPrimaryOpen(false), fPrimaryIndex(-1) {
 	fCounters = new G4int[NUM_COUNTERS];
+	fEventCounters = new G4int[NUM_COUNTERS];
 }
 
 NeutronGEMDataManager::~NeutronGEMDataManager() {
 	delete fHistoManager;
 	delete[] fCounters;
+	delete[] fEventCounters;
 	G4cout << "Deconstructor NeutronGEMDataManager" << G4endl;
 }
 
-NeutronGEMDataManager* NeutronGEMDataManager::fDataManager = 0;
+G4ThreadLocal NeutronGEMDataManager* NeutronGEMDataManager::fDataManager = 0;
+NeutronGEMDataManager* NeutronGEMDataManager::fMasterDataManager = 0;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
 NeutronGEMDataManager* NeutronGEMDataManager::GetInstance() {
 	if (!fDataManager) {
 		fDataManager = new NeutronGEMDataManager();
+		if (G4Threading::IsWorkerThread() && fMasterDataManager) {
+			fDataManager->copyConfiguration(fMasterDataManager);
+			fDataManager->setHistoManager(new NeutronGEMHistoManager());
+		} else {
+			fMasterDataManager = fDataManager;
+		}
 	}
 	return fDataManager;
 }
 void NeutronGEMDataManager::Dispose() {
+	if (fDataManager == fMasterDataManager) {
+		fMasterDataManager = 0;
+	}
 	delete fDataManager;
 	fDataManager = 0;
 }
 
+// Configuration of main(): the counters and the HistoManager are not copied
+void NeutronGEMDataManager::copyConfiguration(
+		const NeutronGEMDataManager* master) {
+	fDescription = master->fDescription;
+	fFilenameGDML = master->fFilenameGDML;
+	fNumberOfEvents = master->fNumberOfEvents;
+	fCathodeThickness = master->fCathodeThickness;
+	fConverterThickness = master->fConverterThickness;
+	fSEEThickness = master->fSEEThickness;
+	fDriftThickness = master->fDriftThickness;
+	fDriftField = master->fDriftField;
+	fCathodeMaterial = master->fCathodeMaterial;
+	fConverterMaterial = master->fConverterMaterial;
+	fSEEMaterial = master->fSEEMaterial;
+}
+
 NeutronGEMHistoManager* NeutronGEMDataManager::getHistoManager() {
 	return fHistoManager;
 }
@@ -155,3 +185,49 @@ G4int* NeutronGEMDataManager::getCounters() {
 void NeutronGEMDataManager::increaseCounter(int number) {
 	 fCounters[number]++;
 }
+
+void NeutronGEMDataManager::BeginOfEvent() {
+	for (int i = 0; i < NUM_COUNTERS; i++) {
+		fEventCounters[i] = 0;
+	}
+	fPrimariesInEvent = 0;
+	fPrimaryOpen = false;
+	fPrimaryIndex = -1;
+}
+
+void NeutronGEMDataManager::EndOfEvent() {
+	EndOfPrimary();
+	fHistoManager->fillTree(fEventCounters, fPrimariesInEvent);
+}
+
+void NeutronGEMDataManager::BeginOfPrimary(G4int index) {
+	EndOfPrimary();
+	resetCounters();
+	fHistoManager->BeginOfEvent();
+	fPrimaryIndex = index;
+	fPrimaryOpen = true;
+}
+
+void NeutronGEMDataManager::EndOfPrimary() {
+	if (!fPrimaryOpen) {
+		return;
+	}
+	fPrimaryOpen = false;
+	fHistoManager->EndOfEvent();
+
+	// counters 16-30: flags telling if counters 1-15 are non zero, summed
+	// over the primaries they count the primaries with such particles
+	for (int i = 1; i <= 15; i++) {
+		if (fCounters[i] >= 1) {
+			fCounters[i + 15] = 1;
+		}
+	}
+	for (int i = 0; i < NUM_COUNTERS; i++) {
+		fEventCounters[i] += fCounters[i];
+	}
+	fPrimariesInEvent++;
+}
+
+G4int NeutronGEMDataManager::getPrimaryIndex() {
+	return fPrimaryIndex;
+}
@@ -41,9 +41,10 @@
 #include "G4SDManager.hh"
 #include "G4VisAttributes.hh"
 #include "G4UnitsTable.hh"
-#include "/home/g4user/g4/geant4.10.00.p02/source/persistency/gdml/include/G4GDMLParser.hh"
 #include "G4LogicalVolumeStore.hh"
 #include "G4ProductionCuts.hh"
+#include "G4RunManager.hh"
+#include "G4AutoDelete.hh"
 #include <TGeoManager.h>
 #include <TCanvas.h>
 
@@ -61,8 +62,14 @@
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-NeutronGEMDetectorConstruction::NeutronGEMDetectorConstruction() :
-		G4VUserDetectorConstruction(), fCheckOverlaps(true), fWorldSize(0), fCathodeThickness(
+G4ThreadLocal GarfieldG4FastSimulationModel* NeutronGEMDetectorConstruction::fGarfieldG4FastSimulationModel = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+NeutronGEMDetectorConstruction::NeutronGEMDetectorConstruction(
+		GarfieldPhysics* garfieldPhysics) :
+		G4VUserDetectorConstruction(), fCheckOverlaps(true), fGarfieldPhysics(
+				garfieldPhysics), fRegionGarfield(0), fWorldSize(0), fCathodeThickness(
 				0), fConverterThickness(0), fSEEThickness(0), fDriftThickness(
 				0), fDriftField(0) {
 	fDataManager = NeutronGEMDataManager::GetInstance();
@@ -228,31 +235,6 @@ G4VPhysicalVolume* NeutronGEMDetectorConstruction::Construct() {
 
 	fDriftField = fDataManager->getDriftField();
 
-	G4ElectricField* fEMfield;
-	G4EqMagElectricField* fEquation;
-	G4MagIntegratorStepper* fStepper;
-	G4double fMinStep;
-	G4ChordFinder* fChordFinder;
-	G4MagInt_Driver* fIntgrDriver;
-	G4FieldManager* fFieldMgr;
-
-	if (fDriftField > 0) {
-		fEMfield = new G4UniformElectricField(
-				G4ThreeVector(0.0, 0.0,
-						-fDriftField * CLHEP::volt / CLHEP::cm));
-
-		fEquation = new G4EqMagElectricField(fEMfield);
-
-		G4int nvar = 8;
-		fStepper = new G4ClassicalRK4(fEquation, nvar);
-
-		fMinStep = 10 * CLHEP::nm;
-
-		fIntgrDriver = new G4MagInt_Driver(fMinStep, fStepper,
-				fStepper->GetNumberOfVariables());
-		fChordFinder = new G4ChordFinder(fIntgrDriver);
-	}
-
 	fSolidWorld = new G4Box("world", 0.5 * fWorldSize, 0.5 * fWorldSize,
 			0.5 * fWorldSize);
 	fLogicalWorld = new G4LogicalVolume(fSolidWorld, fWorldMaterial, "World", 0,
@@ -307,13 +289,6 @@ G4VPhysicalVolume* NeutronGEMDetectorConstruction::Construct() {
 	fPhysicalDrift = new G4PVPlacement(0, positionDrift, fLogicalDrift, "Drift",
 			fLogicalWorld, false, 0, true);
 
-	if (fDriftField > 0) {
-		fFieldMgr = new G4FieldManager(fEMfield);
-		fFieldMgr->SetDetectorField(fEMfield);
-		fFieldMgr->SetChordFinder(fChordFinder);
-		fLogicalDrift->SetFieldManager(fFieldMgr, true);
-	}
-
 	//--------- Visualization attributes -------------------------------
 	fLogicalWorld->SetVisAttributes(G4VisAttributes::Invisible);
 
@@ -334,10 +309,8 @@ G4VPhysicalVolume* NeutronGEMDetectorConstruction::Construct() {
 	G4cout << "fSEEThickness " << fSEEThickness << G4endl;
 	G4cout << "fDriftThickness " << fDriftThickness << G4endl;
 
-	G4Region* regionGarfield = new G4Region("RegionGarfield");
-	regionGarfield->AddRootLogicalVolume(fLogicalDrift);
-	fGarfieldG4FastSimulationModel = new GarfieldG4FastSimulationModel(
-			"GarfieldG4FastSimulationModel", regionGarfield);
+	fRegionGarfield = new G4Region("RegionGarfield");
+	fRegionGarfield->AddRootLogicalVolume(fLogicalDrift);
 
 	G4double cutValue = 0.01 * CLHEP::mm;
 
@@ -345,15 +318,65 @@ G4VPhysicalVolume* NeutronGEMDetectorConstruction::Construct() {
 	cuts->SetProductionCut(cutValue, G4ProductionCuts::GetIndex("gamma"));
 	cuts->SetProductionCut(cutValue, G4ProductionCuts::GetIndex("e-"));
 	cuts->SetProductionCut(cutValue, G4ProductionCuts::GetIndex("e+"));
-	regionGarfield->SetProductionCuts(cuts);
+	fRegionGarfield->SetProductionCuts(cuts);
 
-	fGarfieldG4FastSimulationModel->WriteGeometryToGDML(fPhysicalDrift);
+	// Garfield works in the frame of the drift volume (see the model DoIt)
+	fGarfieldPhysics->SetDriftVolume(fSolidDrift->GetXHalfLength() / CLHEP::cm,
+			fSolidDrift->GetYHalfLength() / CLHEP::cm,
+			fSolidDrift->GetZHalfLength() / CLHEP::cm);
+	if (fDriftField > 0) {
+		fGarfieldPhysics->SetDriftField(fDriftField);
+	}
 
 	return fPhysicalWorld;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void NeutronGEMDetectorConstruction::ConstructSDandField() {
+	G4RunManager::RMType runManagerType =
+			G4RunManager::GetRunManager()->GetRunManagerType();
+	// The master of a multithreaded run does not track particles
+	if (runManagerType == G4RunManager::masterRM) {
+		return;
+	}
+
+	if (fDriftField > 0) {
+		G4ElectricField* fEMfield = new G4UniformElectricField(
+				G4ThreeVector(0.0, 0.0,
+						-fDriftField * CLHEP::volt / CLHEP::cm));
+
+		G4EqMagElectricField* fEquation = new G4EqMagElectricField(fEMfield);
+
+		G4int nvar = 8;
+		G4MagIntegratorStepper* fStepper = new G4ClassicalRK4(fEquation, nvar);
+
+		G4double fMinStep = 10 * CLHEP::nm;
+
+		G4MagInt_Driver* fIntgrDriver = new G4MagInt_Driver(fMinStep, fStepper,
+				fStepper->GetNumberOfVariables());
+		G4ChordFinder* fChordFinder = new G4ChordFinder(fIntgrDriver);
+
+		G4FieldManager* fFieldMgr = new G4FieldManager(fEMfield);
+		fFieldMgr->SetDetectorField(fEMfield);
+		fFieldMgr->SetChordFinder(fChordFinder);
+		fLogicalDrift->SetFieldManager(fFieldMgr, true);
+	}
+
+	fGarfieldG4FastSimulationModel = new GarfieldG4FastSimulationModel(
+			"GarfieldG4FastSimulationModel", fRegionGarfield);
+	if (runManagerType == G4RunManager::workerRM) {
+		// Deleted with its GarfieldPhysics when the thread ends
+		fGarfieldG4FastSimulationModel->SetPhysics(fGarfieldPhysics->Clone());
+		G4AutoDelete::Register(fGarfieldG4FastSimulationModel);
+	} else {
+		// Deleted by main()
+		fGarfieldG4FastSimulationModel->SetPhysics(fGarfieldPhysics);
+	}
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 GarfieldG4FastSimulationModel* NeutronGEMDetectorConstruction::GetGarfieldG4FastSimulationModel() {
 	return fGarfieldG4FastSimulationModel;
 }
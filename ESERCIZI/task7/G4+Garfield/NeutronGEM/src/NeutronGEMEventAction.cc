@@ -31,6 +31,7 @@
 #include "NeutronGEMEventAction.hh"
 #include "NeutronGEMDataManager.hh"
 #include "NeutronGEMHistoManager.hh"
+#include "ProgressReporter.hh"
 #include "G4UImanager.hh"
 #include "G4RunManager.hh"
 #include "G4Event.hh"
@@ -42,7 +43,7 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 NeutronGEMEventAction::NeutronGEMEventAction() :
-		G4UserEventAction(), fPrintModulo(10000) {
+		G4UserEventAction() {
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -52,82 +53,17 @@ NeutronGEMEventAction::~NeutronGEMEventAction() {
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void NeutronGEMEventAction::BeginOfEventAction(const G4Event* evt) {
-	G4int evtNb = evt->GetEventID();
-	NeutronGEMDataManager* dataManager = NeutronGEMDataManager::GetInstance();
-	dataManager->resetCounters();
-	dataManager->getHistoManager()->BeginOfEvent();
-	if (evtNb % fPrintModulo == 0) {
-		time_t rawtime;
-		struct tm * timeinfo;
-		time(&rawtime);
-		timeinfo = localtime(&rawtime);
-		char theTime[50];
-		strftime(theTime, 50, "%Y-%m-%d-%H-%M-%S", timeinfo);
-		G4cout << "\n---> Begin of event: " << evtNb << " " << theTime << G4endl;
-	}
-
+void NeutronGEMEventAction::BeginOfEventAction(const G4Event*) {
+	// The records of the primaries are opened by NeutronGEMTrackingAction
+	NeutronGEMDataManager::GetInstance()->BeginOfEvent();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void NeutronGEMEventAction::EndOfEventAction(const G4Event* evt) {
-	NeutronGEMDataManager* dataManager = NeutronGEMDataManager::GetInstance();
-	dataManager->getHistoManager()->EndOfEvent();
-	G4int* counters = dataManager->getCounters();
-
-	if (counters[1] >= 1) {
-		counters[16] = 1;
-	}
-
-	if (counters[2] >= 1) {
-		counters[17] = 1;
-	}
-	if (counters[3] >= 1) {
-		counters[18] = 1;
-	}
-	if (counters[4] >= 1) {
-		counters[19] = 1;
-	}
-	if (counters[5] >= 1) {
-		counters[20] = 1;
-	}
-	if (counters[6] >= 1) {
-		counters[21] = 1;
-	}
-
-	if (counters[7] >= 1) {
-		counters[22] = 1;
-	}
-	if (counters[8] >= 1) {
-		counters[23] = 1;
-	}
-
-	if (counters[9] >= 1) {
-		counters[24] = 1;
-	}
-	if (counters[10] >= 1) {
-		counters[25] = 1;
-	}
-	if (counters[11] >= 1) {
-		counters[26] = 1;
-	}
-
-	if (counters[12] >= 1) {
-		counters[27] = 1;
-	}
-	if (counters[13] >= 1) {
-		counters[28] = 1;
-	}
-
-	if (counters[14] >= 1) {
-		counters[29] = 1;
-	}
-	if (counters[15] >= 1) {
-		counters[30] = 1;
-	}
-
-	(dataManager->getHistoManager())->fillTree(counters);
+void NeutronGEMEventAction::EndOfEventAction(const G4Event*) {
+	ProgressReporter::GetInstance()->EndOfEvent();
+	// Close the record of the last primary and fill the tree entry
+	NeutronGEMDataManager::GetInstance()->EndOfEvent();
 	//G4int evtNb = evt->GetEventID();
 
 }
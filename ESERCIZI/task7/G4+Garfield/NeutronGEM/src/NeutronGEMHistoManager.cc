@@ -4,7 +4,11 @@
 #include "G4Step.hh"
 #include "G4LossTableManager.hh"
 #include "G4PhysicalConstants.hh"
+#include "G4RunManager.hh"
+#include "G4Threading.hh"
+#include "G4AutoLock.hh"
 
+#include <cstdio>
 #include <iomanip>
 
 #ifdef G4ANALYSIS_USE
@@ -14,20 +18,30 @@
 #include "TBranch.h"
 #include "TFile.h"
 #include "TTree.h"
+#include "TFileMerger.h"
 #endif
 #include "G4SystemOfUnits.hh"
+
+namespace {
+	// ROOT objects are created in the current directory, global in ROOT 5:
+	// the threads book and save their files one at a time
+	G4Mutex histoMutex = G4MUTEX_INITIALIZER;
+}
+
+G4String NeutronGEMHistoManager::fRunFileBase;
+std::map<G4int, G4String> NeutronGEMHistoManager::fWorkerFiles;
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 NeutronGEMHistoManager::NeutronGEMHistoManager() :
-		rootFile(0), fTree(0) {
+		rootFile(0), fTree(0), histo2DReadout(0), fHistoArrivalTime(0) {
 
 	BeginOfEvent();
 
-	for (G4int k = 0; k < NUM_HISTOGRAMS; k++)
+	for (G4int k = 0; k <= NUM_HISTOGRAMS; k++)
 		fHisto[k] = 0;
-	for (G4int k = 0; k < NUM_HISTOGRAMS_2D; k++)
+	for (G4int k = 0; k <= NUM_HISTOGRAMS_2D; k++)
 		histo2DPositionArrivalDrift[k] = 0;
-	for (G4int k = 0; k < NUM_HISTOGRAMS_3D; k++)
+	for (G4int k = 0; k <= NUM_HISTOGRAMS_3D; k++)
 		histo3DEnergyElectrons[k] = 0;
 
 }
@@ -67,22 +81,43 @@ NeutronGEMHistoManager::~NeutronGEMHistoManager() {
 void NeutronGEMHistoManager::book() {
 #ifdef G4ANALYSIS_USE
 
+	G4AutoLock lock(&histoMutex);
+	G4RunManager::RMType runManagerType =
+			G4RunManager::GetRunManager()->GetRunManagerType();
+
 	// Creating a tree container to handle histograms and ntuples.
 	// This tree is associated to an output file.
 	//
 
-	time_t rawtime;
-	struct tm * timeinfo;
-	time(&rawtime);
-	timeinfo = localtime(&rawtime);
-
-	strftime(fStartTime, 50, "%Y-%m-%d-%H-%M-%S", timeinfo);
-	NeutronGEMDataManager* dataManager = NeutronGEMDataManager::GetInstance();
-	G4int numEvents = dataManager->getNumberOfEvents();
-	std::ostringstream sEvents;
-	sEvents << numEvents;
-	G4String fileName = dataManager->getDescription() + "_" + sEvents.str()
-			+ "_" + fStartTime + ".root";
+	if (runManagerType != G4RunManager::workerRM) {
+		time_t rawtime;
+		struct tm * timeinfo;
+		time(&rawtime);
+		timeinfo = localtime(&rawtime);
+
+		strftime(fStartTime, 50, "%Y-%m-%d-%H-%M-%S", timeinfo);
+		NeutronGEMDataManager* dataManager =
+				NeutronGEMDataManager::GetInstance();
+		G4int numEvents = dataManager->getNumberOfEvents();
+		std::ostringstream sEvents;
+		sEvents << numEvents;
+		fRunFileBase = dataManager->getDescription() + "_" + sEvents.str()
+				+ "_" + fStartTime;
+	}
+	fFileName = fRunFileBase + ".root";
+	if (runManagerType == G4RunManager::masterRM) {
+		// The workers fill the histograms, save() merges their files
+		G4cout << "\n----> Histograms of the threads are merged in "
+				<< fFileName << G4endl;
+		return;
+	}
+	if (runManagerType == G4RunManager::workerRM) {
+		std::ostringstream sThread;
+		sThread << fRunFileBase << "_t" << G4Threading::G4GetThreadId()
+				<< ".root";
+		fFileName = sThread.str();
+	}
+	G4String fileName = fFileName;
 
 	rootFile = new TFile(fileName, "RECREATE");
 	if (!rootFile) {
@@ -93,6 +128,7 @@ void NeutronGEMHistoManager::book() {
 
 	fTree = new TTree("Gd GEM", "Gd GEM");
 
+	fTree->Branch("Primaries", &Primaries, "Primaries/I");
 	fTree->Branch("NeutronCapture", &NeutronCapture, "NeutronCapture/I");
 
 	fTree->Branch("ConversionElectronsCreatedConverter",
@@ -281,6 +317,11 @@ void NeutronGEMHistoManager::book() {
 			"Position arrival other electrons drift", 100, -5., 5., 100, -5.,
 			5);
 
+	histo2DReadout = new TH2D("Readout map drift electrons",
+			"Readout map drift electrons", 200, -5., 5., 200, -5., 5.);
+	fHistoArrivalTime = new TH1D("Arrival time drift electrons",
+			"Arrival time drift electrons (ns)", 2000, 0., 2000.);
+
 	G4cout << "\n----> Histogram file is opened in " << fileName << G4endl;
 #endif
 }
@@ -290,18 +331,56 @@ void NeutronGEMHistoManager::book() {
 void NeutronGEMHistoManager::save() {
 #ifdef G4ANALYSIS_USE
 
+	G4AutoLock lock(&histoMutex);
 	if (rootFile) {
 		rootFile->Write();       // Writing the histograms to the file
 		rootFile->Close();    // and closing the tree (and the file)
 		G4cout << "\n----> Histogram Tree is saved \n" << G4endl;
 	}
+
+	G4RunManager::RMType runManagerType =
+			G4RunManager::GetRunManager()->GetRunManagerType();
+	if (runManagerType == G4RunManager::workerRM) {
+		fWorkerFiles[G4Threading::G4GetThreadId()] = fFileName;
+	} else if (runManagerType == G4RunManager::masterRM) {
+		mergeWorkerFiles();
+	}
 #endif
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void NeutronGEMHistoManager::fillTree(G4int* counters) {
+void NeutronGEMHistoManager::mergeWorkerFiles() {
+#ifdef G4ANALYSIS_USE
+	if (fWorkerFiles.empty()) {
+		return;
+	}
+	TFileMerger merger(kFALSE);
+	merger.OutputFile(fFileName, "RECREATE");
+	for (std::map<G4int, G4String>::const_iterator it = fWorkerFiles.begin();
+			it != fWorkerFiles.end(); ++it) {
+		merger.AddFile(it->second);
+	}
+	if (merger.Merge()) {
+		for (std::map<G4int, G4String>::const_iterator it =
+				fWorkerFiles.begin(); it != fWorkerFiles.end(); ++it) {
+			remove(it->second.c_str());
+		}
+		G4cout << "\n----> Histograms of " << fWorkerFiles.size()
+				<< " threads merged in " << fFileName << "\n" << G4endl;
+	} else {
+		G4cout << "\n----> Merging in " << fFileName
+				<< " failed, the files of the threads are kept\n" << G4endl;
+	}
+	fWorkerFiles.clear();
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void NeutronGEMHistoManager::fillTree(G4int* counters, G4int primaries) {
+
+	Primaries = primaries;
 	NeutronCapture = counters[0];
 
 	ConversionElectronsCreatedConverter = counters[1];
@@ -370,6 +449,16 @@ void NeutronGEMHistoManager::Fill2DPositionArrivalDrift(G4int id, G4double xbin,
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
+void NeutronGEMHistoManager::FillReadout(G4double x_cm, G4double y_cm,
+		G4double t_ns) {
+#ifdef G4ANALYSIS_USE
+	if (histo2DReadout) {
+		histo2DReadout->Fill(x_cm, y_cm);
+		fHistoArrivalTime->Fill(t_ns);
+	}
+#endif
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
 void NeutronGEMHistoManager::BeginOfEvent() {
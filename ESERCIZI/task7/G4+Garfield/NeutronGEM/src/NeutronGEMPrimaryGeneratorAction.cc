@@ -29,6 +29,7 @@
 /// \brief Implementation of the NeutronGEMPrimaryGeneratorAction class
 
 #include "NeutronGEMPrimaryGeneratorAction.hh"
+#include "NeutronGEMPrimaryGeneratorMessenger.hh"
 
 #include "G4Event.hh"
 #include "G4GeneralParticleSource.hh"
@@ -38,14 +39,17 @@
 
 
 NeutronGEMPrimaryGeneratorAction::NeutronGEMPrimaryGeneratorAction()
+	: fPrimariesPerEvent(1)
 {
 	fParticleSource = new G4GeneralParticleSource();
+	fMessenger = new NeutronGEMPrimaryGeneratorMessenger(this);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 NeutronGEMPrimaryGeneratorAction::~NeutronGEMPrimaryGeneratorAction()
 {
+	delete fMessenger;
 	delete fParticleSource;
 }
 
@@ -53,9 +57,10 @@ NeutronGEMPrimaryGeneratorAction::~NeutronGEMPrimaryGeneratorAction()
 
 void NeutronGEMPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 {
-	//create vertex
+	//create vertices, one for each independent primary
 	//
-	fParticleSource->GeneratePrimaryVertex(anEvent);
+	for (G4int i = 0; i < fPrimariesPerEvent; i++)
+		fParticleSource->GeneratePrimaryVertex(anEvent);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
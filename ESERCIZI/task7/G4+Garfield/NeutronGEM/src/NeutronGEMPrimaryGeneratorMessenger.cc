@@ -0,0 +1,37 @@
+/// \file NeutronGEMPrimaryGeneratorMessenger.cc
+/// \brief Implementation of the NeutronGEMPrimaryGeneratorMessenger class
+
+#include "NeutronGEMPrimaryGeneratorMessenger.hh"
+#include "NeutronGEMPrimaryGeneratorAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAnInteger.hh"
+
+NeutronGEMPrimaryGeneratorMessenger::NeutronGEMPrimaryGeneratorMessenger(
+		NeutronGEMPrimaryGeneratorAction* generator) :
+		fGenerator(generator) {
+	fGeneratorDir = new G4UIdirectory("/generator/");
+	fGeneratorDir->SetGuidance("primary generation");
+
+	fPrimariesCmd = new G4UIcmdWithAnInteger("/generator/primariesPerEvent", this);
+	fPrimariesCmd->SetGuidance("Number of independent primaries (from /gps/) in each event.");
+	fPrimariesCmd->SetGuidance("The tree has one entry per event, with the counters summed over its primaries.");
+	fPrimariesCmd->SetParameterName("primaries", false);
+	fPrimariesCmd->SetRange("primaries>0");
+	fPrimariesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+NeutronGEMPrimaryGeneratorMessenger::~NeutronGEMPrimaryGeneratorMessenger() {
+	delete fPrimariesCmd;
+	delete fGeneratorDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void NeutronGEMPrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command,
+		G4String newValue) {
+	if (command == fPrimariesCmd)
+		fGenerator->SetPrimariesPerEvent(fPrimariesCmd->GetNewIntValue(newValue));
+}
@@ -36,13 +36,20 @@
 #include "G4UnitsTable.hh"
 #include "NeutronGEMDataManager.hh"
 #include "NeutronGEMHistoManager.hh"
+#include "ProgressReporter.hh"
+#include "StepProfiler.hh"
+#include "NeutronGEMDetectorConstruction.hh"
+#include "GarfieldG4FastSimulationModel.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 NeutronGEMRunAction::NeutronGEMRunAction()
 	: G4UserRunAction(), fNumberOfEvents(0)
 {  
-
+	// Create the reporter and the profiler now so that their UI commands
+	// are available
+	ProgressReporter::GetInstance();
+	StepProfiler::GetInstance();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -55,6 +62,11 @@ NeutronGEMRunAction::~NeutronGEMRunAction()
 void NeutronGEMRunAction::BeginOfRunAction(const G4Run* run)
 { 
 	fTime = time(NULL);
+	ProgressReporter::GetInstance()->BeginOfRun(run->GetNumberOfEventToBeProcessed());
+	StepProfiler::GetInstance()->BeginOfRun();
+	GarfieldG4FastSimulationModel* garfieldModel =
+			NeutronGEMDetectorConstruction::GetGarfieldG4FastSimulationModel();
+	if (garfieldModel) garfieldModel->ResetCounters();
 
 	G4cout << "### Run " << run->GetRunID() << " started" << G4endl;
 	NeutronGEMDataManager* dataManager =
@@ -71,13 +83,24 @@ void NeutronGEMRunAction::BeginOfRunAction(const G4Run* run)
 void NeutronGEMRunAction::EndOfRunAction(const G4Run* run)
 {
 	fTime = time(NULL) - fTime;
+	ProgressReporter::GetInstance()->EndOfRun();
+	StepProfiler::GetInstance()->EndOfRun();
+	GarfieldG4FastSimulationModel* garfieldModel =
+			NeutronGEMDetectorConstruction::GetGarfieldG4FastSimulationModel();
+	if (garfieldModel) {
+		G4cout << "### Garfield model: " << garfieldModel->GetNumberOfTriggers()
+				<< " triggers, " << garfieldModel->GetNumberOfDoIts() << " DoIt" << G4endl;
+	}
 
 	fNumberOfEvents = run->GetNumberOfEvent();
-	if (fNumberOfEvents == 0) return;
-	G4cout << "### Run " << run->GetRunID() << " of " << fNumberOfEvents << " took " << fTime << " s" << G4endl;
 	NeutronGEMDataManager* dataManager =
 				NeutronGEMDataManager::GetInstance();
-	dataManager->setNumberOfEvents(fNumberOfEvents);
+	// The file booked by every thread is saved, also without events:
+	// the master merges the files of all the workers
+	if (fNumberOfEvents > 0) {
+		G4cout << "### Run " << run->GetRunID() << " of " << fNumberOfEvents << " took " << fTime << " s" << G4endl;
+		dataManager->setNumberOfEvents(fNumberOfEvents);
+	}
 	(dataManager->getHistoManager())->save();
 
 }
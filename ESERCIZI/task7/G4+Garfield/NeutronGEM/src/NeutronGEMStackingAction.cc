@@ -49,6 +49,7 @@ NeutronGEMStackingAction::~NeutronGEMStackingAction()
 G4ClassificationOfNewTrack
 	NeutronGEMStackingAction::ClassifyNewTrack(const G4Track* track)
 {
+	// NeutronGEMTrackingAction relies on all the tracks being urgent
 	return fUrgent;
 	/*
 	if(track->GetParticleDefinition()->GetParticleName() == "gamma" )
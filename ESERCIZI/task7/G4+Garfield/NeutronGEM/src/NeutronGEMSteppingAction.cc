@@ -41,6 +41,9 @@
 #include "NeutronGEMDataManager.hh"
 #include "NeutronGEMHistoManager.hh"
 #include "NeutronGEMTrackInformation.hh"
+#include "ProgressReporter.hh"
+#include "StepProfiler.hh"
+#include "ParticleSpecies.hh"
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 NeutronGEMSteppingAction::NeutronGEMSteppingAction() :
@@ -56,14 +59,19 @@ NeutronGEMSteppingAction::~NeutronGEMSteppingAction() {
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void NeutronGEMSteppingAction::UserSteppingAction(const G4Step* theStep) {
+	ProgressReporter::GetInstance()->AddStep();
+	StepProfiler* profiler = StepProfiler::GetInstance();
+	if ( profiler->IsEnabled() ) profiler->AddStep(theStep);
 	NeutronGEMDataManager* dataManager = NeutronGEMDataManager::GetInstance();
 	NeutronGEMHistoManager* histoManager = dataManager->getHistoManager();
 	NeutronGEMTrackInformation* trackInfo = 0;
-	G4String ancestorName = "neutron";
+	//Particles are classified by PDG encoding, no string comparison per step
+	ParticleSpecies::Species ancestor = ParticleSpecies::kNeutron;
 	if (theStep->GetTrack()->GetUserInformation()) {
 		trackInfo =
 				(NeutronGEMTrackInformation*) (theStep->GetTrack()->GetUserInformation());
-		ancestorName = trackInfo->GetParticleDefinition()->GetParticleName();
+		ancestor = ParticleSpecies::GetSpecies(
+				trackInfo->GetParticleDefinition()->GetPDGEncoding());
 	}
 
 	G4StepPoint* preStep = theStep->GetPreStepPoint();
@@ -81,9 +89,9 @@ void NeutronGEMSteppingAction::UserSteppingAction(const G4Step* theStep) {
 	G4double energy = theStep->GetPreStepPoint()->GetKineticEnergy()/ CLHEP::MeV;
 	G4double energy_eV = theStep->GetPreStepPoint()->GetKineticEnergy()/ CLHEP::eV;
 	G4ParticleDefinition* thePartDef = fTrack->GetDefinition();
-	G4String partName = thePartDef->GetParticleName();
-	G4String partType = thePartDef->GetParticleType();
-	G4String volumeNamePresent = physVol->GetName();
+	ParticleSpecies::Species species = ParticleSpecies::GetSpecies(
+			thePartDef->GetPDGEncoding());
+	const G4String& volumeNamePresent = physVol->GetName();
 	double x = localPosition.getX() / CLHEP::cm;
 	double y = localPosition.getY() / CLHEP::cm;
 	double z = localPosition.getZ() / CLHEP::cm;
@@ -91,19 +99,19 @@ void NeutronGEMSteppingAction::UserSteppingAction(const G4Step* theStep) {
 	double dx = fTrack->GetMomentumDirection().getX();
 	double dy = fTrack->GetMomentumDirection().getY();
 	double dz = fTrack->GetMomentumDirection().getZ();
-	G4String volumeNameNext = "";
-	if (fTrack->GetNextVolume()) {
-		volumeNameNext = fTrack->GetNextVolume()->GetName();
-	}
+	static const G4String noVolume = "";
+	const G4String& volumeNameNext = fTrack->GetNextVolume() ?
+			fTrack->GetNextVolume()->GetName() : noVolume;
 
 	if (fTrack->GetCurrentStepNumber() == 1) {
 		if (volumeNamePresent == "Converter") {
-			if (partName == "gamma") {
+			if (species == ParticleSpecies::kGamma) {
 				dataManager->increaseCounter(4);
 				histoManager->fillHistogram(4, energy);
 
-			} else if (partName == "e-") {
-				if (fTrack->GetParentID() == 1) {
+			} else if (species == ParticleSpecies::kElectron) {
+				// daughter of the primary: described by its own track information
+				if (trackInfo && trackInfo->GetOriginalTrackID() == fTrack->GetTrackID()) {
 					dataManager->increaseCounter(1);
 					histoManager->fillHistogram(1, energy);
 
@@ -111,10 +119,10 @@ void NeutronGEMSteppingAction::UserSteppingAction(const G4Step* theStep) {
 					dataManager->increaseCounter(5);
 					histoManager->fillHistogram(5, energy );
 				}
-			} else if (partName == "alpha") {
+			} else if (species == ParticleSpecies::kAlpha) {
 				dataManager->increaseCounter(2);
 				histoManager->fillHistogram(2, energy);
-			} else if (partName == "Li7") {
+			} else if (species == ParticleSpecies::kLi7) {
 				dataManager->increaseCounter(3);
 				histoManager->fillHistogram(3, energy);
 			}
@@ -127,28 +135,28 @@ void NeutronGEMSteppingAction::UserSteppingAction(const G4Step* theStep) {
 		} else if (volumeNamePresent == "SEE") {
 			//
 		} else if (volumeNamePresent == "Drift") {
-			if (partName == "e-") {
-				if (ancestorName == "e-") {
+			if (species == ParticleSpecies::kElectron) {
+				if (ancestor == ParticleSpecies::kElectron) {
 					dataManager->increaseCounter(11);
 					histoManager->fillHistogram(11, energy);
 					histoManager->Fill3DEnergyElectrons(1, x, y, z,
 							energy_eV );
 					histoManager->AddClustersConversionElectrons();
-				} else if (ancestorName == "gamma") {
+				} else if (ancestor == ParticleSpecies::kGamma) {
 					dataManager->increaseCounter(14);
 					histoManager->fillHistogram(14, energy );
 					histoManager->Fill3DEnergyElectrons(5, x, y, z,
 							energy_eV);
 					histoManager->AddClustersOtherElectrons();
 				}
-			} else if (ancestorName == "alpha") {
+			} else if (ancestor == ParticleSpecies::kAlpha) {
 				dataManager->increaseCounter(12);
 				histoManager->fillHistogram(12, energy);
 				histoManager->Fill3DEnergyElectrons(2, x, y, z,
 						energy_eV);
 				histoManager->AddClustersAlphas();
 
-			} else if (ancestorName == "Li7") {
+			} else if (ancestor == ParticleSpecies::kLi7) {
 				dataManager->increaseCounter(13);
 				histoManager->fillHistogram(13, energy);
 				histoManager->Fill3DEnergyElectrons(3, x, y, z,
@@ -161,18 +169,18 @@ void NeutronGEMSteppingAction::UserSteppingAction(const G4Step* theStep) {
 
 	if (volumeNamePresent == "Drift") {
 		G4double edep = theStep->GetTotalEnergyDeposit()/MeV;
-		if (partName == "e-") {
-			if (ancestorName == "e-") {
+		if (species == ParticleSpecies::kElectron) {
+			if (ancestor == ParticleSpecies::kElectron) {
 				histoManager->AddEnergyConversionElectrons(edep);
 
 			} else {
 				histoManager->AddEnergyOtherElectrons(edep);
 			}
-		} else if (partName == "gamma") {
+		} else if (species == ParticleSpecies::kGamma) {
 			histoManager->AddEnergyGammas(edep);
-		} else if (partName == "alpha") {
+		} else if (species == ParticleSpecies::kAlpha) {
 			histoManager->AddEnergyAlphas(edep);
-		} else if (partName == "Li7") {
+		} else if (species == ParticleSpecies::kLi7) {
 			histoManager->AddEnergyLiIons(edep);
 		}
 	}
@@ -180,7 +188,7 @@ void NeutronGEMSteppingAction::UserSteppingAction(const G4Step* theStep) {
 	if (postStep->GetStepStatus() == fGeomBoundary) {
 		if (volumeNameNext == "SEE") {
 			if (volumeNamePresent == "Cathode") {
-				if (partName == "e-") {
+				if (species == ParticleSpecies::kElectron) {
 					//dataManager->increaseCounter(2);
 					//histoManager->fillHistogram(2, energy / CLHEP::MeV);
 				}
@@ -188,27 +196,27 @@ void NeutronGEMSteppingAction::UserSteppingAction(const G4Step* theStep) {
 		} else if (volumeNameNext == "Drift") {
 			if (volumeNamePresent == "SEE" || volumeNamePresent == "Cathode") {
 				double d = sqrt(x * x + y * y);
-				if (partName == "gamma") {
+				if (species == ParticleSpecies::kGamma) {
 					dataManager->increaseCounter(9);
 					histoManager->fillHistogram(9, energy);
 					histoManager->fillHistogram(19, d );
 					histoManager->Fill2DPositionArrivalDrift(4, x, y);
 
-				} else if (partName == "alpha") {
+				} else if (species == ParticleSpecies::kAlpha) {
 					dataManager->increaseCounter(7);
 					histoManager->fillHistogram(7, energy);
 					histoManager->fillHistogram(17, d );
 					histoManager->Fill2DPositionArrivalDrift(2, x, y);
 
-				} else if (partName == "Li7") {
+				} else if (species == ParticleSpecies::kLi7) {
 					dataManager->increaseCounter(8);
 					histoManager->fillHistogram(8, energy);
 					histoManager->fillHistogram(18, d );
 					histoManager->Fill2DPositionArrivalDrift(3, x, y);
 
-				} else if (partName == "e-") {
+				} else if (species == ParticleSpecies::kElectron) {
 
-					if (ancestorName == "e-") {
+					if (ancestor == ParticleSpecies::kElectron) {
 						dataManager->increaseCounter(6);
 						histoManager->fillHistogram(6, energy );
 						histoManager->fillHistogram(16, d );
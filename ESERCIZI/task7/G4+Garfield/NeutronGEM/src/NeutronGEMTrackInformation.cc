@@ -15,6 +15,7 @@ NeutronGEMTrackInformation::NeutronGEMTrackInformation()
     fOriginalMomentum = G4ThreeVector(0.,0.,0.);
     fOriginalEnergy = 0.;
     fOriginalTime = 0.;
+    fPrimaryIndex = 0;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -27,6 +28,7 @@ NeutronGEMTrackInformation::NeutronGEMTrackInformation(const G4Track* aTrack)
     fOriginalMomentum = aTrack->GetMomentum();
     fOriginalEnergy = aTrack->GetKineticEnergy();
     fOriginalTime = aTrack->GetGlobalTime();
+    fPrimaryIndex = 0;
   }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -40,6 +42,7 @@ NeutronGEMTrackInformation
     fOriginalMomentum = aTrackInfo->fOriginalMomentum;
     fOriginalEnergy = aTrackInfo->fOriginalEnergy;
     fOriginalTime = aTrackInfo->fOriginalTime;
+    fPrimaryIndex = aTrackInfo->fPrimaryIndex;
 
 }
 
@@ -57,6 +60,7 @@ NeutronGEMTrackInformation& NeutronGEMTrackInformation
     fOriginalMomentum = aTrackInfo.fOriginalMomentum;
     fOriginalEnergy = aTrackInfo.fOriginalEnergy;
     fOriginalTime = aTrackInfo.fOriginalTime;
+    fPrimaryIndex = aTrackInfo.fPrimaryIndex;
 
 
     return *this;
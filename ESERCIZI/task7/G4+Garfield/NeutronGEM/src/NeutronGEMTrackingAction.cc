@@ -31,20 +31,39 @@
 
 #include "NeutronGEMTrackingAction.hh"
 #include "NeutronGEMTrackInformation.hh"
+#include "NeutronGEMDataManager.hh"
 
 #include "G4TrackingManager.hh"
 #include "G4Track.hh"
+#include "G4Exception.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 NeutronGEMTrackingAction::NeutronGEMTrackingAction() :
-		G4UserTrackingAction() {
+		G4UserTrackingAction(), fPrimaryTrackID(0) {
 	;
 }
 
 void NeutronGEMTrackingAction::PreUserTrackingAction(const G4Track* aTrack) {
-	if (aTrack->GetParentID() == 1 && aTrack->GetUserInformation() == 0) {
+	NeutronGEMDataManager* dataManager = NeutronGEMDataManager::GetInstance();
+	if (aTrack->GetParentID() == 0) {
+		// primaries are numbered 1..N in the order they were generated
+		fPrimaryTrackID = aTrack->GetTrackID();
+		dataManager->BeginOfPrimary(fPrimaryTrackID - 1);
+	} else if (aTrack->GetUserInformation() != 0 ?
+			((NeutronGEMTrackInformation*) aTrack->GetUserInformation())->GetPrimaryIndex()
+					!= dataManager->getPrimaryIndex() :
+			aTrack->GetParentID() != fPrimaryTrackID) {
+		// The record of its primary is already closed (only the daughters
+		// of the current primary have no information yet): some tracks
+		// were not urgent, see NeutronGEMStackingAction
+		G4Exception("NeutronGEMTrackingAction::PreUserTrackingAction",
+				"NeutronGEM001", FatalException,
+				"Secondary tracked after the next primary: all the tracks must be urgent");
+	}
+	if (aTrack->GetParentID() == fPrimaryTrackID && aTrack->GetUserInformation() == 0) {
 		NeutronGEMTrackInformation* anInfo = new NeutronGEMTrackInformation(
 				aTrack);
+		anInfo->SetPrimaryIndex(fPrimaryTrackID - 1);
 		G4Track* theTrack = (G4Track*) aTrack;
 		theTrack->SetUserInformation(anInfo);
 	}